@@ -38,6 +38,9 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct LRUCacheOptions, low_pri_pool_ratio),
           OptionType::kDouble, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"numa_aware",
+         {offsetof(struct LRUCacheOptions, numa_aware), OptionType::kBoolean,
+          OptionVerificationType::kNormal, OptionTypeFlags::kMutable}},
 };
 
 static std::unordered_map<std::string, OptionTypeInfo>
@@ -64,6 +67,16 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    enable_custom_split_merge),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"max_compressed_size_ratio",
+         {offsetof(struct CompressedSecondaryCacheOptions,
+                   max_compressed_size_ratio),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"uncompressed_hot_block_promotions",
+         {offsetof(struct CompressedSecondaryCacheOptions,
+                   uncompressed_hot_block_promotions),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 };
 
 Status SecondaryCache::CreateFromString(
@@ -6,12 +6,14 @@
 #include "cache/compressed_secondary_cache.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstdint>
 #include <memory>
 
 #include "memory/memory_allocator.h"
 #include "monitoring/perf_context_imp.h"
 #include "util/compression.h"
+#include "util/hash.h"
 #include "util/string_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -23,16 +25,27 @@ CompressedSecondaryCache::CompressedSecondaryCache(
     CacheMetadataChargePolicy metadata_charge_policy,
     CompressionType compression_type, uint32_t compress_format_version,
     bool enable_custom_split_merge,
-    const CacheEntryRoleSet& do_not_compress_roles)
+    const CacheEntryRoleSet& do_not_compress_roles,
+    double max_compressed_size_ratio,
+    uint32_t uncompressed_hot_block_promotions)
     : cache_options_(capacity, num_shard_bits, strict_capacity_limit,
                      high_pri_pool_ratio, low_pri_pool_ratio, memory_allocator,
                      use_adaptive_mutex, metadata_charge_policy,
                      compression_type, compress_format_version,
                      enable_custom_split_merge, do_not_compress_roles) {
+  cache_options_.max_compressed_size_ratio = max_compressed_size_ratio;
+  cache_options_.uncompressed_hot_block_promotions =
+      uncompressed_hot_block_promotions;
   cache_ =
       NewLRUCache(capacity, num_shard_bits, strict_capacity_limit,
                   high_pri_pool_ratio, memory_allocator, use_adaptive_mutex,
                   metadata_charge_policy, low_pri_pool_ratio);
+  if (uncompressed_hot_block_promotions > 0) {
+    // About a counter per 4KB block, bounding the sketch to 2MB
+    size_t num_counters = std::min<size_t>(
+        std::max<size_t>(capacity / 4096, 1 << 12), 1 << 22);
+    promotions_.reset(new FrequencySketch(num_counters));
+  }
 }
 
 CompressedSecondaryCache::~CompressedSecondaryCache() { cache_.reset(); }
@@ -55,6 +68,12 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     return nullptr;
   }
 
+  const bool compressed =
+      ShouldCompress(helper->role) &&
+      cache_->GetCacheItemHelper(lru_handle) !=
+          GetHelper(cache_options_.enable_custom_split_merge,
+                    /*kept_uncompressed=*/true);
+
   CacheAllocationPtr* ptr{nullptr};
   CacheAllocationPtr merged_value;
   size_t handle_value_charge{0};
@@ -72,8 +91,7 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
   Status s;
   Cache::ObjectPtr value{nullptr};
   size_t charge{0};
-  if (cache_options_.compression_type == kNoCompression ||
-      cache_options_.do_not_compress_roles.Contains(helper->role)) {
+  if (!compressed) {
     s = helper->create_cb(Slice(ptr->get(), handle_value_charge),
                           create_context, allocator, &value, &charge);
   } else {
@@ -100,6 +118,10 @@ std::unique_ptr<SecondaryCacheResultHandle> CompressedSecondaryCache::Lookup(
     return nullptr;
   }
 
+  if (promotions_) {
+    promotions_->Record(GetSliceNPHash64(key));
+  }
+
   if (advise_erase) {
     cache_->Release(lru_handle, /*erase_if_last_ref=*/true);
     // Insert a dummy handle.
@@ -124,8 +146,8 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
   }
 
   Cache::Handle* lru_handle = cache_->Lookup(key);
-  auto internal_helper = GetHelper(cache_options_.enable_custom_split_merge);
   if (lru_handle == nullptr) {
+    auto internal_helper = GetHelper(cache_options_.enable_custom_split_merge);
     PERF_COUNTER_ADD(compressed_sec_cache_insert_dummy_count, 1);
     // Insert a dummy handle if the handle is evicted for the first time.
     return cache_->Insert(key, /*obj=*/nullptr, internal_helper,
@@ -144,9 +166,16 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
   }
   Slice val(ptr.get(), size);
 
+  bool compressed = ShouldCompress(helper->role);
+  if (compressed && promotions_ &&
+      promotions_->Estimate(GetSliceNPHash64(key)) >=
+          cache_options_.uncompressed_hot_block_promotions) {
+    // A hot block, don't make its next promotions decompress it
+    compressed = false;
+  }
+
   std::string compressed_val;
-  if (cache_options_.compression_type != kNoCompression &&
-      !cache_options_.do_not_compress_roles.Contains(helper->role)) {
+  if (compressed) {
     PERF_COUNTER_ADD(compressed_sec_cache_uncompressed_bytes, size);
     CompressionOptions compression_opts;
     CompressionContext compression_context(cache_options_.compression_type);
@@ -163,17 +192,28 @@ Status CompressedSecondaryCache::Insert(const Slice& key,
       return Status::Corruption("Error compressing value.");
     }
 
-    val = Slice(compressed_val);
-    size = compressed_val.size();
-    PERF_COUNTER_ADD(compressed_sec_cache_compressed_bytes, size);
-
-    if (!cache_options_.enable_custom_split_merge) {
-      ptr = AllocateBlock(size, cache_options_.memory_allocator.get());
-      memcpy(ptr.get(), compressed_val.data(), size);
+    if (cache_options_.max_compressed_size_ratio > 0 &&
+        static_cast<double>(compressed_val.size()) >
+            cache_options_.max_compressed_size_ratio *
+                static_cast<double>(size)) {
+      // Not worth decompressing on each promotion, keep the block as is
+      compressed = false;
+    } else {
+      val = Slice(compressed_val);
+      size = compressed_val.size();
+      PERF_COUNTER_ADD(compressed_sec_cache_compressed_bytes, size);
+
+      if (!cache_options_.enable_custom_split_merge) {
+        ptr = AllocateBlock(size, cache_options_.memory_allocator.get());
+        memcpy(ptr.get(), compressed_val.data(), size);
+      }
     }
   }
 
   PERF_COUNTER_ADD(compressed_sec_cache_insert_real_count, 1);
+  bool kept_uncompressed = !compressed && ShouldCompress(helper->role);
+  auto internal_helper =
+      GetHelper(cache_options_.enable_custom_split_merge, kept_uncompressed);
   if (cache_options_.enable_custom_split_merge) {
     size_t charge{0};
     CacheValueChunk* value_chunks_head =
@@ -212,6 +252,13 @@ std::string CompressedSecondaryCache::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "    compress_format_version : %d\n",
            cache_options_.compress_format_version);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    max_compressed_size_ratio : %lf\n",
+           cache_options_.max_compressed_size_ratio);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "    uncompressed_hot_block_promotions : %" PRIu32 "\n",
+           cache_options_.uncompressed_hot_block_promotions);
+  ret.append(buffer);
   return ret;
 }
 
@@ -286,10 +333,9 @@ CacheAllocationPtr CompressedSecondaryCache::MergeChunksIntoValue(
 }
 
 const Cache::CacheItemHelper* CompressedSecondaryCache::GetHelper(
-    bool enable_custom_split_merge) const {
+    bool enable_custom_split_merge, bool kept_uncompressed) const {
   if (enable_custom_split_merge) {
-    static const Cache::CacheItemHelper kHelper{
-        CacheEntryRole::kMisc,
+    static constexpr Cache::DeleterFn kDeleter =
         [](Cache::ObjectPtr obj, MemoryAllocator* /*alloc*/) {
           CacheValueChunk* chunks_head = static_cast<CacheValueChunk*>(obj);
           while (chunks_head != nullptr) {
@@ -298,16 +344,23 @@ const Cache::CacheItemHelper* CompressedSecondaryCache::GetHelper(
             tmp_chunk->Free();
             obj = nullptr;
           };
-        }};
-    return &kHelper;
+        };
+    static const Cache::CacheItemHelper kHelper{CacheEntryRole::kMisc,
+                                                kDeleter};
+    static const Cache::CacheItemHelper kUncompressedHelper{
+        CacheEntryRole::kMisc, kDeleter};
+    return kept_uncompressed ? &kUncompressedHelper : &kHelper;
   } else {
-    static const Cache::CacheItemHelper kHelper{
-        CacheEntryRole::kMisc,
+    static constexpr Cache::DeleterFn kDeleter =
         [](Cache::ObjectPtr obj, MemoryAllocator* /*alloc*/) {
           delete static_cast<CacheAllocationPtr*>(obj);
           obj = nullptr;
-        }};
-    return &kHelper;
+        };
+    static const Cache::CacheItemHelper kHelper{CacheEntryRole::kMisc,
+                                                kDeleter};
+    static const Cache::CacheItemHelper kUncompressedHelper{
+        CacheEntryRole::kMisc, kDeleter};
+    return kept_uncompressed ? &kUncompressedHelper : &kHelper;
   }
 }
 
@@ -330,12 +383,13 @@ std::shared_ptr<SecondaryCache> NewCompressedSecondaryCache(
     const CompressedSecondaryCacheOptions& opts) {
   // The secondary_cache is disabled for this LRUCache instance.
   assert(opts.secondary_cache == nullptr);
-  return NewCompressedSecondaryCache(
+  return std::make_shared<CompressedSecondaryCache>(
       opts.capacity, opts.num_shard_bits, opts.strict_capacity_limit,
       opts.high_pri_pool_ratio, opts.low_pri_pool_ratio, opts.memory_allocator,
       opts.use_adaptive_mutex, opts.metadata_charge_policy,
       opts.compression_type, opts.compress_format_version,
-      opts.enable_custom_split_merge, opts.do_not_compress_roles);
+      opts.enable_custom_split_merge, opts.do_not_compress_roles,
+      opts.max_compressed_size_ratio, opts.uncompressed_hot_block_promotions);
 }
 
 }  // namespace ROCKSDB_NAMESPACE
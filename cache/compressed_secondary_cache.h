@@ -15,6 +15,7 @@
 #include "rocksdb/slice.h"
 #include "rocksdb/status.h"
 #include "util/compression.h"
+#include "util/frequency_sketch.h"
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -80,7 +81,9 @@ class CompressedSecondaryCache : public SecondaryCache {
       uint32_t compress_format_version = 2,
       bool enable_custom_split_merge = false,
       const CacheEntryRoleSet& do_not_compress_roles = {
-          CacheEntryRole::kFilterBlock});
+          CacheEntryRole::kFilterBlock},
+      double max_compressed_size_ratio = 0.0,
+      uint32_t uncompressed_hot_block_promotions = 0);
   ~CompressedSecondaryCache() override;
 
   const char* Name() const override { return "CompressedSecondaryCache"; }
@@ -132,10 +135,24 @@ class CompressedSecondaryCache : public SecondaryCache {
   CacheAllocationPtr MergeChunksIntoValue(const void* chunks_head,
                                           size_t& charge);
 
+  // Whether a block of this role should be stored compressed, unless it's
+  // hot or doesn't compress well
+  bool ShouldCompress(CacheEntryRole role) const {
+    return cache_options_.compression_type != kNoCompression &&
+           !cache_options_.do_not_compress_roles.Contains(role);
+  }
+
   // TODO: clean up to use cleaner interfaces in typed_cache.h
-  const Cache::CacheItemHelper* GetHelper(bool enable_custom_split_merge) const;
+  // The entries that are stored uncompressed although their role is
+  // compressed have their own helper, which tells Lookup() to not uncompress
+  // them.
+  const Cache::CacheItemHelper* GetHelper(bool enable_custom_split_merge,
+                                          bool kept_uncompressed = false) const;
   std::shared_ptr<Cache> cache_;
   CompressedSecondaryCacheOptions cache_options_;
+  // Estimates how many times the blocks were recently promoted, if
+  // uncompressed_hot_block_promotions > 0
+  std::unique_ptr<FrequencySketch> promotions_;
   mutable port::Mutex capacity_mutex_;
 };
 
@@ -954,6 +954,73 @@ TEST_P(CompressedSecCacheTestWithCompressAndSplitParam, BasicIntegrationTest) {
   BasicIntegrationTest(sec_cache_is_compressed_, enable_custom_split_merge_);
 }
 
+TEST_P(CompressedSecCacheTestWithCompressAndSplitParam, PerBlockCompression) {
+  CompressedSecondaryCacheOptions opts;
+  opts.capacity = 1 << 20;
+  opts.num_shard_bits = 0;
+  opts.max_compressed_size_ratio = 0.9;
+  opts.uncompressed_hot_block_promotions = 2;
+  opts.enable_custom_split_merge = enable_custom_split_merge_;
+  if (sec_cache_is_compressed_) {
+    if (!LZ4_Supported()) {
+      ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+      opts.compression_type = CompressionType::kNoCompression;
+      sec_cache_is_compressed_ = false;
+    }
+  } else {
+    opts.compression_type = CompressionType::kNoCompression;
+  }
+  std::shared_ptr<SecondaryCache> sec_cache = NewCompressedSecondaryCache(opts);
+
+  bool kept_in_sec_cache{true};
+  auto promote = [&](const std::string& key, const std::string& str) {
+    std::unique_ptr<SecondaryCacheResultHandle> handle =
+        sec_cache->Lookup(key, GetHelper(), this, true, /*advise_erase=*/true,
+                          kept_in_sec_cache);
+    ASSERT_NE(handle, nullptr);
+    std::unique_ptr<TestItem> val =
+        std::unique_ptr<TestItem>(static_cast<TestItem*>(handle->Value()));
+    ASSERT_NE(val, nullptr);
+    ASSERT_EQ(val->Size(), str.size());
+    ASSERT_EQ(memcmp(val->Buf(), str.data(), str.size()), 0);
+  };
+
+  // A block that doesn't compress is stored uncompressed
+  std::string junk(Random(301).RandomBinaryString(1000));
+  TestItem junk_item(junk.data(), junk.length());
+  get_perf_context()->Reset();
+  ASSERT_OK(sec_cache->Insert(key1, &junk_item, GetHelper()));
+  ASSERT_OK(sec_cache->Insert(key1, &junk_item, GetHelper()));
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 1);
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_uncompressed_bytes,
+            sec_cache_is_compressed_ ? 1000 : 0);
+  ASSERT_EQ(get_perf_context()->compressed_sec_cache_compressed_bytes, 0);
+  promote(key1, junk);
+
+  // A block that compresses well is stored compressed, until it was promoted
+  // twice
+  std::string str(1000, 'a');
+  TestItem item(str.data(), str.length());
+  ASSERT_OK(sec_cache->Insert(key2, &item, GetHelper()));
+  for (int i = 0; i < 3; ++i) {
+    get_perf_context()->Reset();
+    ASSERT_OK(sec_cache->Insert(key2, &item, GetHelper()));
+    ASSERT_EQ(get_perf_context()->compressed_sec_cache_insert_real_count, 1);
+    if (sec_cache_is_compressed_ && i < 2) {
+      ASSERT_EQ(get_perf_context()->compressed_sec_cache_uncompressed_bytes,
+                1000);
+      ASSERT_GT(get_perf_context()->compressed_sec_cache_compressed_bytes, 0);
+      ASSERT_LT(get_perf_context()->compressed_sec_cache_compressed_bytes,
+                100);
+    } else {
+      ASSERT_EQ(get_perf_context()->compressed_sec_cache_uncompressed_bytes,
+                0);
+      ASSERT_EQ(get_perf_context()->compressed_sec_cache_compressed_bytes, 0);
+    }
+    promote(key2, str);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(CompressedSecCacheTests,
                         CompressedSecCacheTestWithCompressAndSplitParam,
                         ::testing::Combine(testing::Bool(), testing::Bool(),
@@ -120,7 +120,8 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
                              CacheMetadataChargePolicy metadata_charge_policy,
                              int max_upper_hash_bits,
                              MemoryAllocator* allocator,
-                             const Cache::EvictionCallback* eviction_callback)
+                             const Cache::EvictionCallback* eviction_callback,
+                             uint32_t shard_group)
     : CacheShardBase(metadata_charge_policy),
       capacity_(0),
       high_pri_pool_usage_(0),
@@ -134,7 +135,8 @@ LRUCacheShard::LRUCacheShard(size_t capacity, bool strict_capacity_limit,
       usage_(0),
       lru_usage_(0),
       mutex_(use_adaptive_mutex),
-      eviction_callback_(*eviction_callback) {
+      eviction_callback_(*eviction_callback),
+      shard_group_(shard_group) {
   // Make empty circular linked list.
   lru_.next = &lru_;
   lru_.prev = &lru_;
@@ -532,6 +534,7 @@ LRUHandle* LRUCacheShard::CreateHandle(const Slice& key, uint32_t hash,
   e->value = value;
   e->m_flags = 0;
   e->im_flags = 0;
+  e->SetShardGroup(shard_group_);
   e->helper = helper;
   e->key_length = key.size();
   e->hash = hash;
@@ -651,18 +654,20 @@ LRUCache::LRUCache(size_t capacity, int num_shard_bits,
                    double low_pri_pool_ratio,
                    std::shared_ptr<MemoryAllocator> allocator,
                    bool use_adaptive_mutex,
-                   CacheMetadataChargePolicy metadata_charge_policy)
+                   CacheMetadataChargePolicy metadata_charge_policy,
+                   uint32_t num_shard_groups)
     : ShardedCache(capacity, num_shard_bits, strict_capacity_limit,
-                   std::move(allocator)) {
+                   std::move(allocator),
+                   std::min(num_shard_groups, LRUHandle::kMaxShardGroups)) {
   size_t per_shard = GetPerShardCapacity();
   MemoryAllocator* alloc = memory_allocator();
   const EvictionCallback* eviction_callback = &eviction_callback_;
-  InitShards([=](LRUCacheShard* cs) {
+  InitShardsInGroups([=](uint32_t group, LRUCacheShard* cs) {
     new (cs) LRUCacheShard(per_shard, strict_capacity_limit,
                            high_pri_pool_ratio, low_pri_pool_ratio,
                            use_adaptive_mutex, metadata_charge_policy,
                            /* max_upper_hash_bits */ 32 - num_shard_bits, alloc,
-                           eviction_callback);
+                           eviction_callback, group);
   });
 }
 
@@ -699,6 +704,18 @@ std::shared_ptr<Cache> NewLRUCache(
     CacheMetadataChargePolicy metadata_charge_policy,
     const std::shared_ptr<SecondaryCache>& secondary_cache,
     double low_pri_pool_ratio) {
+  LRUCacheOptions cache_opts(capacity, num_shard_bits, strict_capacity_limit,
+                             high_pri_pool_ratio, std::move(memory_allocator),
+                             use_adaptive_mutex, metadata_charge_policy,
+                             low_pri_pool_ratio);
+  cache_opts.secondary_cache = secondary_cache;
+  return NewLRUCache(cache_opts);
+}
+
+std::shared_ptr<Cache> NewLRUCache(const LRUCacheOptions& cache_opts) {
+  int num_shard_bits = cache_opts.num_shard_bits;
+  double high_pri_pool_ratio = cache_opts.high_pri_pool_ratio;
+  double low_pri_pool_ratio = cache_opts.low_pri_pool_ratio;
   if (num_shard_bits >= 20) {
     return nullptr;  // The cache cannot be sharded into too many fine pieces.
   }
@@ -714,28 +731,26 @@ std::shared_ptr<Cache> NewLRUCache(
     // Invalid high_pri_pool_ratio and low_pri_pool_ratio combination
     return nullptr;
   }
+  uint32_t num_shard_groups = 1;
+  if (cache_opts.numa_aware) {
+    num_shard_groups = static_cast<uint32_t>(port::NumNumaNodes());
+  }
   if (num_shard_bits < 0) {
-    num_shard_bits = GetDefaultCacheShardBits(capacity);
+    num_shard_bits =
+        GetDefaultCacheShardBits(cache_opts.capacity / num_shard_groups);
   }
   std::shared_ptr<Cache> cache = std::make_shared<LRUCache>(
-      capacity, num_shard_bits, strict_capacity_limit, high_pri_pool_ratio,
-      low_pri_pool_ratio, std::move(memory_allocator), use_adaptive_mutex,
-      metadata_charge_policy);
-  if (secondary_cache) {
-    cache = std::make_shared<CacheWithSecondaryAdapter>(cache, secondary_cache);
+      cache_opts.capacity, num_shard_bits, cache_opts.strict_capacity_limit,
+      high_pri_pool_ratio, low_pri_pool_ratio, cache_opts.memory_allocator,
+      cache_opts.use_adaptive_mutex, cache_opts.metadata_charge_policy,
+      num_shard_groups);
+  if (cache_opts.secondary_cache) {
+    cache = std::make_shared<CacheWithSecondaryAdapter>(
+        cache, cache_opts.secondary_cache);
   }
   return cache;
 }
 
-std::shared_ptr<Cache> NewLRUCache(const LRUCacheOptions& cache_opts) {
-  return NewLRUCache(cache_opts.capacity, cache_opts.num_shard_bits,
-                     cache_opts.strict_capacity_limit,
-                     cache_opts.high_pri_pool_ratio,
-                     cache_opts.memory_allocator, cache_opts.use_adaptive_mutex,
-                     cache_opts.metadata_charge_policy,
-                     cache_opts.secondary_cache, cache_opts.low_pri_pool_ratio);
-}
-
 std::shared_ptr<Cache> NewLRUCache(
     size_t capacity, int num_shard_bits, bool strict_capacity_limit,
     double high_pri_pool_ratio,
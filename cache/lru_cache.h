@@ -86,6 +86,9 @@ struct LRUHandle {
     // Marks result handles that should not be inserted into cache
     IM_IS_STANDALONE = (1 << 2),
   };
+  // The upper bits of im_flags hold the shard group of the owning shard
+  static constexpr int kShardGroupShift = 3;
+  static constexpr uint32_t kMaxShardGroups = 1U << (8 - kShardGroupShift);
 
   // Beginning of the key (MUST BE THE LAST FIELD IN THIS STRUCT!)
   char key_data[1];
@@ -115,6 +118,14 @@ struct LRUHandle {
   bool InLowPriPool() const { return m_flags & M_IN_LOW_PRI_POOL; }
   bool HasHit() const { return m_flags & M_HAS_HIT; }
   bool IsStandalone() const { return im_flags & IM_IS_STANDALONE; }
+  uint32_t GetShardGroup() const { return im_flags >> kShardGroupShift; }
+
+  void SetShardGroup(uint32_t group) {
+    assert(group < kMaxShardGroups);
+    im_flags = static_cast<uint8_t>(
+        (im_flags & ((1U << kShardGroupShift) - 1)) |
+        (group << kShardGroupShift));
+  }
 
   void SetInCache(bool in_cache) {
     if (in_cache) {
@@ -271,7 +282,8 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
                 bool use_adaptive_mutex,
                 CacheMetadataChargePolicy metadata_charge_policy,
                 int max_upper_hash_bits, MemoryAllocator* allocator,
-                const Cache::EvictionCallback* eviction_callback);
+                const Cache::EvictionCallback* eviction_callback,
+                uint32_t shard_group = 0);
 
  public:  // Type definitions expected as parameter to ShardedCache
   using HandleImpl = LRUHandle;
@@ -282,6 +294,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
   static inline HashVal ComputeHash(const Slice& key) {
     return Lower32of64(GetSliceNPHash64(key));
   }
+  static inline uint32_t GetShardGroup(const LRUHandle* handle) {
+    return handle->GetShardGroup();
+  }
 
   // Separate from constructor so caller can easily make an array of LRUCache
   // if current usage is more than new capacity, the function will attempt to
@@ -438,6 +453,9 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShardBase {
 
   // A reference to Cache::eviction_callback_
   const Cache::EvictionCallback& eviction_callback_;
+
+  // Recorded in the handles of this shard
+  const uint32_t shard_group_;
 };
 
 class LRUCache
@@ -451,7 +469,8 @@ class LRUCache
            std::shared_ptr<MemoryAllocator> memory_allocator = nullptr,
            bool use_adaptive_mutex = kDefaultToAdaptiveMutex,
            CacheMetadataChargePolicy metadata_charge_policy =
-               kDontChargeCacheMetadata);
+               kDontChargeCacheMetadata,
+           uint32_t num_shard_groups = 1);
   const char* Name() const override { return "LRUCache"; }
   ObjectPtr Value(Handle* handle) override;
   size_t GetCharge(Handle* handle) const override;
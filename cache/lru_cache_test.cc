@@ -369,6 +369,125 @@ TEST_F(LRUCacheTest, EntriesWithPriority) {
   ValidateLRUList({"x", "y", "g", "z", "d", "m"}, 2, 2, 2);
 }
 
+TEST(LRUCacheShardGroupsTest, Basic) {
+  // Two shard groups of two shards, like a cache on a two node NUMA system
+  auto cache = std::make_shared<LRUCache>(
+      /*capacity=*/1024, /*num_shard_bits=*/1, /*strict_capacity_limit=*/false,
+      /*high_pri_pool_ratio=*/0.0, /*low_pri_pool_ratio=*/0.0,
+      /*memory_allocator=*/nullptr, kDefaultToAdaptiveMutex,
+      kDontChargeCacheMetadata, /*num_shard_groups=*/2);
+  ASSERT_EQ(cache->GetNumShards(), 2U);
+  ASSERT_EQ(cache->GetNumShardGroups(), 2U);
+
+  int node = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::CurrentShardGroup",
+      [&](void* arg) { *static_cast<int*>(arg) = node; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  auto insert = [&](const std::string& key, size_t charge) {
+    ASSERT_OK(
+        cache->Insert(key, nullptr /*value*/, &kNoopCacheItemHelper, charge));
+  };
+  auto lookup = [&](const std::string& key) -> bool {
+    Cache::Handle* handle = cache->Lookup(key);
+    if (handle == nullptr) {
+      return false;
+    }
+    cache->Release(handle);
+    return true;
+  };
+
+  // Entries inserted from one node are found from the other one
+  node = 0;
+  insert("a", 1);
+  node = 1;
+  insert("b", 1);
+  ASSERT_TRUE(lookup("a"));
+  node = 0;
+  ASSERT_TRUE(lookup("b"));
+  ASSERT_EQ(cache->GetUsage(), 2U);
+
+  // Re-inserting from the other node replaces the entry
+  node = 1;
+  insert("a", 10);
+  ASSERT_EQ(cache->GetUsage(), 11U);
+  node = 0;
+  Cache::Handle* handle = cache->Lookup("a");
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(cache->GetCharge(handle), 10U);
+  // Released into the node 1 shard that owns it
+  node = 1;
+  ASSERT_TRUE(cache->Release(handle, /*useful=*/true,
+                             /*erase_if_last_ref=*/true));
+  ASSERT_FALSE(lookup("a"));
+
+  cache->Erase("b");
+  ASSERT_FALSE(lookup("b"));
+  ASSERT_EQ(cache->GetUsage(), 0U);
+
+  // The capacity is split over the shards of both groups
+  for (int i = 0; i < 8; i++) {
+    node = i % 2;
+    insert("k" + std::to_string(i), 256);
+  }
+  ASSERT_LE(cache->GetUsage(), 1024U);
+
+  size_t num_entries = 0;
+  cache->ApplyToAllEntries(
+      [&](const Slice& /*key*/, Cache::ObjectPtr /*value*/, size_t /*charge*/,
+          const Cache::CacheItemHelper* /*helper*/) { num_entries++; },
+      {});
+  ASSERT_EQ(num_entries * 256, cache->GetUsage());
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST(LRUCacheShardGroupsTest, ConcurrentInsertsOfAKey) {
+  auto cache = std::make_shared<LRUCache>(
+      /*capacity=*/1024, /*num_shard_bits=*/1, /*strict_capacity_limit=*/false,
+      /*high_pri_pool_ratio=*/0.0, /*low_pri_pool_ratio=*/0.0,
+      /*memory_allocator=*/nullptr, kDefaultToAdaptiveMutex,
+      kDontChargeCacheMetadata, /*num_shard_groups=*/2);
+
+  static thread_local int thread_node = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedCacheBase::CurrentShardGroup",
+      [&](void* arg) { *static_cast<int*>(arg) = thread_node; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Threads of both nodes keep replacing the same key
+  constexpr int kNumInserts = 2000;
+  std::vector<port::Thread> threads;
+  for (int node = 0; node < 2; node++) {
+    threads.emplace_back([&, node]() {
+      thread_node = node;
+      for (int i = 0; i < kNumInserts; i++) {
+        ASSERT_OK(cache->Insert("a", nullptr /*value*/, &kNoopCacheItemHelper,
+                                1 + node));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Only the last insert is left, in one of the groups
+  size_t usage = cache->GetUsage();
+  ASSERT_TRUE(usage == 1U || usage == 2U);
+  for (int node = 0; node < 2; node++) {
+    thread_node = node;
+    Cache::Handle* handle = cache->Lookup("a");
+    ASSERT_NE(handle, nullptr);
+    ASSERT_EQ(cache->GetCharge(handle), usage);
+    cache->Release(handle);
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 namespace clock_cache {
 
 class ClockCacheTest : public testing::Test {
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "test_util/sync_point.h"
 #include "util/hash.h"
 #include "util/math.h"
 #include "util/mutexlock.h"
@@ -21,18 +22,26 @@ namespace ROCKSDB_NAMESPACE {
 
 ShardedCacheBase::ShardedCacheBase(size_t capacity, int num_shard_bits,
                                    bool strict_capacity_limit,
-                                   std::shared_ptr<MemoryAllocator> allocator)
+                                   std::shared_ptr<MemoryAllocator> allocator,
+                                   uint32_t num_shard_groups)
     : Cache(std::move(allocator)),
       last_id_(1),
       shard_mask_((uint32_t{1} << num_shard_bits) - 1),
+      num_shard_groups_(std::max(num_shard_groups, 1U)),
       strict_capacity_limit_(strict_capacity_limit),
       capacity_(capacity) {}
 
 size_t ShardedCacheBase::ComputePerShardCapacity(size_t capacity) const {
-  uint32_t num_shards = GetNumShards();
+  uint32_t num_shards = GetNumShards() * num_shard_groups_;
   return (capacity + (num_shards - 1)) / num_shards;
 }
 
+uint32_t ShardedCacheBase::CurrentShardGroup() const {
+  int node = port::CurrentNumaNode();
+  TEST_SYNC_POINT_CALLBACK("ShardedCacheBase::CurrentShardGroup", &node);
+  return static_cast<uint32_t>(std::max(node, 0)) % num_shard_groups_;
+}
+
 size_t ShardedCacheBase::GetPerShardCapacity() const {
   return ComputePerShardCapacity(GetCapacity());
 }
@@ -68,6 +77,9 @@ std::string ShardedCacheBase::GetPrintableOptions() const {
     snprintf(buffer, kBufferSize, "    num_shard_bits : %d\n",
              GetNumShardBits());
     ret.append(buffer);
+    snprintf(buffer, kBufferSize, "    num_shard_groups : %u\n",
+             num_shard_groups_);
+    ret.append(buffer);
     snprintf(buffer, kBufferSize, "    strict_capacity_limit : %d\n",
              strict_capacity_limit_);
     ret.append(buffer);
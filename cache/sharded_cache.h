@@ -11,11 +11,13 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "port/lang.h"
 #include "port/port.h"
 #include "rocksdb/advanced_cache.h"
+#include "util/autovector.h"
 #include "util/hash.h"
 #include "util/mutexlock.h"
 
@@ -40,6 +42,12 @@ class CacheShardBase {
   static inline uint32_t HashPieceForSharding(HashCref hash) {
     return Lower32of64(hash);
   }
+  // Implementations that support several shard groups record the group of
+  // the owning shard in each handle and hide this one
+  template <class HandleImpl>
+  static inline uint32_t GetShardGroup(const HandleImpl* /*handle*/) {
+    return 0;
+  }
   void AppendPrintableOptions(std::string& /*str*/) const {}
 
   // Must be provided for concept CacheShard (TODO with C++20 support)
@@ -91,11 +99,14 @@ class ShardedCacheBase : public Cache {
  public:
   ShardedCacheBase(size_t capacity, int num_shard_bits,
                    bool strict_capacity_limit,
-                   std::shared_ptr<MemoryAllocator> memory_allocator);
+                   std::shared_ptr<MemoryAllocator> memory_allocator,
+                   uint32_t num_shard_groups = 1);
   virtual ~ShardedCacheBase() = default;
 
   int GetNumShardBits() const;
+  // Number of shards in each shard group
   uint32_t GetNumShards() const;
+  uint32_t GetNumShardGroups() const { return num_shard_groups_; }
 
   uint64_t NewId() override;
 
@@ -110,10 +121,13 @@ class ShardedCacheBase : public Cache {
   virtual void AppendPrintableOptions(std::string& str) const = 0;
   size_t GetPerShardCapacity() const;
   size_t ComputePerShardCapacity(size_t capacity) const;
+  // The shard group of the NUMA node the calling thread runs on
+  uint32_t CurrentShardGroup() const;
 
  protected:                        // data
   std::atomic<uint64_t> last_id_;  // For NewId
   const uint32_t shard_mask_;
+  const uint32_t num_shard_groups_;
 
   // Dynamic configuration parameters, guarded by config_mutex_
   bool strict_capacity_limit_;
@@ -127,6 +141,14 @@ class ShardedCacheBase : public Cache {
 // so that the upper bits of the hash value can keep a stable ordering of
 // table entries even as the table grows (using more upper hash bits).
 // See CacheShardBase above for what is expected of the CacheShard parameter.
+//
+// With num_shard_groups > 1 there is a group of 2^num_shard_bits shards per
+// NUMA node, allocated on that node. Entries are inserted into the group of
+// the inserting thread's node, so blocks that are mostly read from the node
+// that read them from the file stay node-local, and lookups first probe the
+// local group and then the remote ones. The capacity is split evenly over
+// all the shards of all the groups. Inserts of keys of the same stripe are
+// serialized, so a key is in at most one group once its inserts completed.
 template <class CacheShard>
 class ShardedCache : public ShardedCacheBase {
  public:
@@ -135,20 +157,39 @@ class ShardedCache : public ShardedCacheBase {
   using HandleImpl = typename CacheShard::HandleImpl;
 
   ShardedCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit,
-               std::shared_ptr<MemoryAllocator> allocator)
+               std::shared_ptr<MemoryAllocator> allocator,
+               uint32_t num_shard_groups = 1)
       : ShardedCacheBase(capacity, num_shard_bits, strict_capacity_limit,
-                         allocator),
-        shards_(reinterpret_cast<CacheShard*>(port::cacheline_aligned_alloc(
-            sizeof(CacheShard) * GetNumShards()))),
-        destroy_shards_in_dtor_(false) {}
+                         allocator, num_shard_groups),
+        numa_allocated_groups_(0),
+        shards_(AllocateShardGroup(0)),
+        destroy_shards_in_dtor_(false) {
+    shard_groups_.push_back(shards_);
+    for (uint32_t group = 1; group < num_shard_groups_; group++) {
+      shard_groups_.push_back(AllocateShardGroup(group));
+    }
+    // numa_allocated_groups_ has a bit per group
+    assert(num_shard_groups_ <= 64);
+    if (num_shard_groups_ > 1) {
+      insert_mutexes_.reset(new port::Mutex[kNumInsertMutexes]);
+    }
+  }
 
   virtual ~ShardedCache() {
     if (destroy_shards_in_dtor_) {
       ForEachShard([](CacheShard* cs) { cs->~CacheShard(); });
     }
-    port::cacheline_aligned_free(shards_);
+    for (uint32_t group = 0; group < num_shard_groups_; group++) {
+      if (numa_allocated_groups_ & (uint64_t{1} << group)) {
+        port::FreeOnNumaNode(shard_groups_[group],
+                             sizeof(CacheShard) * GetNumShards());
+      } else {
+        port::cacheline_aligned_free(shard_groups_[group]);
+      }
+    }
   }
 
+  // The shard of the first shard group
   CacheShard& GetShard(HashCref hash) {
     return shards_[CacheShard::HashPieceForSharding(hash) & shard_mask_];
   }
@@ -157,6 +198,23 @@ class ShardedCache : public ShardedCacheBase {
     return shards_[CacheShard::HashPieceForSharding(hash) & shard_mask_];
   }
 
+  CacheShard& GetShard(uint32_t group, HashCref hash) {
+    return shard_groups_[group]
+                        [CacheShard::HashPieceForSharding(hash) & shard_mask_];
+  }
+
+  const CacheShard& GetShard(uint32_t group, HashCref hash) const {
+    return shard_groups_[group]
+                        [CacheShard::HashPieceForSharding(hash) & shard_mask_];
+  }
+
+  CacheShard& GetShardOfHandle(const HandleImpl* h) {
+    if (num_shard_groups_ == 1) {
+      return GetShard(h->GetHash());
+    }
+    return GetShard(CacheShard::GetShardGroup(h), h->GetHash());
+  }
+
   void SetCapacity(size_t capacity) override {
     MutexLock l(&config_mutex_);
     capacity_ = capacity;
@@ -177,8 +235,22 @@ class ShardedCache : public ShardedCacheBase {
     assert(helper);
     HashVal hash = CacheShard::ComputeHash(key);
     auto h_out = reinterpret_cast<HandleImpl**>(handle);
-    return GetShard(hash).Insert(key, hash, obj, helper, charge, h_out,
-                                 priority);
+    if (num_shard_groups_ == 1) {
+      return GetShard(hash).Insert(key, hash, obj, helper, charge, h_out,
+                                   priority);
+    }
+    uint32_t group = CurrentShardGroup();
+    // Like a single shard, the new entry replaces the one of the same key,
+    // whichever group it is in. Without the lock, concurrent inserts of the
+    // key from different nodes could each erase before the other inserts,
+    // and leave both entries in the cache.
+    MutexLock l(&insert_mutexes_[CacheShard::HashPieceForSharding(hash) %
+                                 kNumInsertMutexes]);
+    for (uint32_t i = 1; i < num_shard_groups_; i++) {
+      GetShard((group + i) % num_shard_groups_, hash).Erase(key, hash);
+    }
+    return GetShard(group, hash).Insert(key, hash, obj, helper, charge, h_out,
+                                        priority);
   }
 
   Handle* CreateStandalone(const Slice& key, ObjectPtr obj,
@@ -186,8 +258,11 @@ class ShardedCache : public ShardedCacheBase {
                            bool allow_uncharged) override {
     assert(helper);
     HashVal hash = CacheShard::ComputeHash(key);
-    HandleImpl* result = GetShard(hash).CreateStandalone(
-        key, hash, obj, helper, charge, allow_uncharged);
+    CacheShard& shard = num_shard_groups_ == 1
+                            ? GetShard(hash)
+                            : GetShard(CurrentShardGroup(), hash);
+    HandleImpl* result = shard.CreateStandalone(key, hash, obj, helper, charge,
+                                                allow_uncharged);
     return reinterpret_cast<Handle*>(result);
   }
 
@@ -196,24 +271,36 @@ class ShardedCache : public ShardedCacheBase {
                  Priority priority = Priority::LOW,
                  Statistics* stats = nullptr) override {
     HashVal hash = CacheShard::ComputeHash(key);
-    HandleImpl* result = GetShard(hash).Lookup(key, hash, helper,
-                                               create_context, priority, stats);
+    if (num_shard_groups_ == 1) {
+      HandleImpl* result = GetShard(hash).Lookup(
+          key, hash, helper, create_context, priority, stats);
+      return reinterpret_cast<Handle*>(result);
+    }
+    // A remote hit is still much cheaper than reading the block again
+    uint32_t group = CurrentShardGroup();
+    HandleImpl* result = nullptr;
+    for (uint32_t i = 0; result == nullptr && i < num_shard_groups_; i++) {
+      result = GetShard((group + i) % num_shard_groups_, hash)
+                   .Lookup(key, hash, helper, create_context, priority, stats);
+    }
     return reinterpret_cast<Handle*>(result);
   }
 
   void Erase(const Slice& key) override {
     HashVal hash = CacheShard::ComputeHash(key);
-    GetShard(hash).Erase(key, hash);
+    for (uint32_t group = 0; group < num_shard_groups_; group++) {
+      GetShard(group, hash).Erase(key, hash);
+    }
   }
 
   bool Release(Handle* handle, bool useful,
                bool erase_if_last_ref = false) override {
     auto h = reinterpret_cast<HandleImpl*>(handle);
-    return GetShard(h->GetHash()).Release(h, useful, erase_if_last_ref);
+    return GetShardOfHandle(h).Release(h, useful, erase_if_last_ref);
   }
   bool Ref(Handle* handle) override {
     auto h = reinterpret_cast<HandleImpl*>(handle);
-    return GetShard(h->GetHash()).Ref(h);
+    return GetShardOfHandle(h).Ref(h);
   }
   bool Release(Handle* handle, bool erase_if_last_ref = false) override {
     return Release(handle, true /*useful*/, erase_if_last_ref);
@@ -225,6 +312,17 @@ class ShardedCache : public ShardedCacheBase {
   size_t GetPinnedUsage() const override {
     return SumOverShards2(&CacheShard::GetPinnedUsage);
   }
+  size_t GetShardCapacity(const Slice& /*key*/) const override {
+    return GetPerShardCapacity();
+  }
+  size_t GetShardPinnedUsage(const Slice& key) const override {
+    HashVal hash = CacheShard::ComputeHash(key);
+    // The shard an insert of the key from this thread would go to
+    const CacheShard& shard = num_shard_groups_ == 1
+                                  ? GetShard(hash)
+                                  : GetShard(CurrentShardGroup(), hash);
+    return shard.GetPinnedUsage();
+  }
   size_t GetOccupancyCount() const override {
     return SumOverShards2(&CacheShard::GetPinnedUsage);
   }
@@ -238,7 +336,8 @@ class ShardedCache : public ShardedCacheBase {
     uint32_t num_shards = GetNumShards();
     // Iterate over part of each shard, rotating between shards, to
     // minimize impact on latency of concurrent operations.
-    std::unique_ptr<size_t[]> states(new size_t[num_shards]{});
+    std::unique_ptr<size_t[]> states(
+        new size_t[num_shards * num_shard_groups_]{});
 
     size_t aepl = opts.average_entries_per_lock;
     aepl = std::min(aepl, size_t{1});
@@ -246,10 +345,13 @@ class ShardedCache : public ShardedCacheBase {
     bool remaining_work;
     do {
       remaining_work = false;
-      for (uint32_t i = 0; i < num_shards; i++) {
-        if (states[i] != SIZE_MAX) {
-          shards_[i].ApplyToSomeEntries(callback, aepl, &states[i]);
-          remaining_work |= states[i] != SIZE_MAX;
+      for (uint32_t group = 0; group < num_shard_groups_; group++) {
+        for (uint32_t i = 0; i < num_shards; i++) {
+          size_t& state = states[group * num_shards + i];
+          if (state != SIZE_MAX) {
+            shard_groups_[group][i].ApplyToSomeEntries(callback, aepl, &state);
+            remaining_work |= state != SIZE_MAX;
+          }
         }
       }
     } while (remaining_work);
@@ -269,8 +371,21 @@ class ShardedCache : public ShardedCacheBase {
  protected:
   inline void ForEachShard(const std::function<void(CacheShard*)>& fn) {
     uint32_t num_shards = GetNumShards();
-    for (uint32_t i = 0; i < num_shards; i++) {
-      fn(shards_ + i);
+    for (CacheShard* group_shards : shard_groups_) {
+      for (uint32_t i = 0; i < num_shards; i++) {
+        fn(group_shards + i);
+      }
+    }
+  }
+
+  // Like ForEachShard, also passing the shard group of each shard
+  inline void ForEachShardInGroups(
+      const std::function<void(uint32_t group, CacheShard*)>& fn) {
+    uint32_t num_shards = GetNumShards();
+    for (uint32_t group = 0; group < num_shard_groups_; group++) {
+      for (uint32_t i = 0; i < num_shards; i++) {
+        fn(group, shard_groups_[group] + i);
+      }
     }
   }
 
@@ -278,8 +393,10 @@ class ShardedCache : public ShardedCacheBase {
       const std::function<size_t(CacheShard&)>& fn) const {
     uint32_t num_shards = GetNumShards();
     size_t result = 0;
-    for (uint32_t i = 0; i < num_shards; i++) {
-      result += fn(shards_[i]);
+    for (CacheShard* group_shards : shard_groups_) {
+      for (uint32_t i = 0; i < num_shards; i++) {
+        result += fn(group_shards[i]);
+      }
     }
     return result;
   }
@@ -294,12 +411,40 @@ class ShardedCache : public ShardedCacheBase {
     destroy_shards_in_dtor_ = true;
   }
 
+  // Like InitShards, for caches that record the shard group in the handles
+  void InitShardsInGroups(
+      const std::function<void(uint32_t group, CacheShard*)>& placement_new) {
+    ForEachShardInGroups(placement_new);
+    destroy_shards_in_dtor_ = true;
+  }
+
   void AppendPrintableOptions(std::string& str) const override {
     shards_[0].AppendPrintableOptions(str);
   }
 
  private:
+  static constexpr uint32_t kNumInsertMutexes = 64;
+
+  CacheShard* AllocateShardGroup(uint32_t group) {
+    size_t size = sizeof(CacheShard) * GetNumShards();
+    if (num_shard_groups_ > 1) {
+      void* mem = port::AllocateOnNumaNode(size, static_cast<int>(group));
+      if (mem != nullptr) {
+        numa_allocated_groups_ |= uint64_t{1} << group;
+        return reinterpret_cast<CacheShard*>(mem);
+      }
+    }
+    return reinterpret_cast<CacheShard*>(port::cacheline_aligned_alloc(size));
+  }
+
+  // Bit i is set if shard group i was allocated with AllocateOnNumaNode
+  uint64_t numa_allocated_groups_;
+  // The shards of the first shard group
   CacheShard* const shards_;
+  // The shards of each shard group, shards_ first
+  autovector<CacheShard*, 1> shard_groups_;
+  // With several shard groups, serialize the inserts of the keys of a stripe
+  std::unique_ptr<port::Mutex[]> insert_mutexes_;
   bool destroy_shards_in_dtor_;
 };
 
@@ -68,6 +68,10 @@ class ArenaWrappedDBIter : public Iterator {
   void SeekForPrev(const Slice& target) override {
     db_iter_->SeekForPrev(target);
   }
+  void SeekMany(const std::vector<Slice>& targets,
+                const std::function<bool(size_t)>& callback) override {
+    db_iter_->SeekMany(targets, callback);
+  }
   void Next() override { db_iter_->Next(); }
   void Prev() override { db_iter_->Prev(); }
   Slice key() const override { return db_iter_->key(); }
@@ -229,6 +229,67 @@ TEST_F(DBBlobBasicTest, IterateBlobsFromCache) {
   }
 }
 
+TEST_F(DBBlobBasicTest, IterateBlobsWithReadahead) {
+  Options options = GetDefaultOptions();
+  options.enable_blob_files = true;
+
+  Reopen(options);
+
+  constexpr int num_blobs = 20;
+  std::vector<std::string> keys;
+  std::vector<std::string> blobs;
+
+  for (int i = 0; i < num_blobs; ++i) {
+    keys.push_back("key" + std::to_string(100 + i));
+    blobs.push_back(std::string(100, static_cast<char>('a' + i)));
+    ASSERT_OK(Put(keys[i], blobs[i]));
+  }
+  ASSERT_OK(Flush());
+
+  int num_blob_file_reads = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlobFileReader::GetBlob:ReadFromFile",
+      [&](void* /* arg */) { ++num_blob_file_reads; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  for (size_t blob_readahead_size : {size_t{0}, size_t{64 << 10}}) {
+    ReadOptions read_options;
+    read_options.blob_readahead_size = blob_readahead_size;
+    num_blob_file_reads = 0;
+
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+
+    int i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+      ++i;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, num_blobs);
+
+    // Without readahead, each blob is read separately; with it, all the blobs
+    // are served from the readahead buffer of the blob file.
+    ASSERT_EQ(num_blob_file_reads, blob_readahead_size == 0 ? num_blobs : 0);
+
+    // Reverse scans don't read ahead: each blob would be read with the
+    // readahead size of the blobs that follow it, which were already read
+    num_blob_file_reads = 0;
+    i = num_blobs;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      --i;
+      ASSERT_EQ(iter->key().ToString(), keys[i]);
+      ASSERT_EQ(iter->value().ToString(), blobs[i]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(i, 0);
+    ASSERT_EQ(num_blob_file_reads, num_blobs);
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBBlobBasicTest, IterateBlobsFromCachePinning) {
   constexpr size_t min_blob_size = 6;
 
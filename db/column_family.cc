@@ -1545,6 +1545,11 @@ Status ColumnFamilyData::ValidateOptions(
           "The garbage ratio threshold for forcing blob garbage collection "
           "should be in the range [0.0, 1.0].");
     }
+    if (cf_options.blob_garbage_collection_force_max_batches == 0) {
+      return Status::InvalidArgument(
+          "The maximum number of blob file batches for forcing blob garbage "
+          "collection should be at least 1.");
+    }
   }
 
   if (cf_options.compaction_style == kCompactionStyleFIFO &&
@@ -1757,7 +1762,9 @@ ColumnFamilyData* ColumnFamilySet::CreateColumnFamily(
 
 void ColumnFamilyData::UpdateCFRate(void* client_id, uint64_t write_rate) {
   if (write_controller_ && write_controller_->is_dynamic_delay()) {
-    write_controller_->HandleNewDelayReq(client_id, write_rate);
+    write_controller_->HandleNewDelayReq(
+        client_id, write_rate,
+        column_family_set_->write_controller_writer_id());
   }
 }
 
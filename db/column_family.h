@@ -770,6 +770,10 @@ class ColumnFamilySet {
     return write_controller_.get();
   }
 
+  // Identifies the DB of this set when delaying through a WriteController
+  // with weighted fair delay.
+  const void* write_controller_writer_id() const { return db_options_; }
+
  private:
   friend class ColumnFamilyData;
   // helper function that gets called from cfd destructor
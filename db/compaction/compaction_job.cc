@@ -581,9 +581,15 @@ void CompactionJob::GenSubcompactionBoundaries() {
                            &num_planned_subcompactions);
   if (num_planned_subcompactions == 1) return;
 
+  // The input may be split into more ranges than threads, in which case the
+  // threads take the next range as they finish one (see Run())
+  const uint64_t num_planned_ranges =
+      num_planned_subcompactions *
+      std::max(mutable_db_options_copy_.subcompaction_ranges_per_thread, 1U);
+
   // Group the ranges into subcompactions
   uint64_t target_range_size = std::max(
-      total_size / num_planned_subcompactions,
+      total_size / num_planned_ranges,
       MaxFileSizeForLevel(
           *(c->mutable_cf_options()), out_lvl,
           c->immutable_options()->compaction_style, base_level,
@@ -595,18 +601,20 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   uint64_t next_threshold = target_range_size;
   uint64_t cumulative_size = 0;
-  uint64_t num_actual_subcompactions = 1U;
+  uint64_t num_actual_ranges = 1U;
   for (TableReader::Anchor& anchor : all_anchors) {
     cumulative_size += anchor.range_size;
     if (cumulative_size > next_threshold) {
       next_threshold += target_range_size;
-      num_actual_subcompactions++;
+      num_actual_ranges++;
       boundaries_.push_back(anchor.user_key);
     }
-    if (num_actual_subcompactions == num_planned_subcompactions) {
+    if (num_actual_ranges == num_planned_ranges) {
       break;
     }
   }
+  uint64_t num_actual_subcompactions =
+      std::min(num_actual_ranges, num_planned_subcompactions);
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:1",
                            &num_actual_subcompactions);
   // Shrink extra subcompactions resources when extra resrouces are acquired
@@ -622,21 +630,34 @@ Status CompactionJob::Run() {
   log_buffer_->FlushBufferToLog();
   LogCompaction();
 
-  const size_t num_threads = compact_->sub_compact_states.size();
-  assert(num_threads > 0);
+  const size_t num_subcompactions = compact_->sub_compact_states.size();
+  assert(num_subcompactions > 0);
+  // There may be more subcompactions (key ranges) than threads, see
+  // subcompaction_ranges_per_thread
+  const size_t num_threads = std::min(
+      num_subcompactions, static_cast<size_t>(GetSubcompactionsLimit()));
   const uint64_t start_micros = db_options_.clock->NowMicros();
 
+  // Every thread starts with its own subcompaction, and then takes the next
+  // unprocessed one until there are none left
+  std::atomic<size_t> next_subcompaction(num_threads);
+  auto process_subcompactions = [&](size_t first) {
+    for (size_t i = first; i < num_subcompactions;
+         i = next_subcompaction.fetch_add(1)) {
+      ProcessKeyValueCompaction(&compact_->sub_compact_states[i]);
+    }
+  };
+
   // Launch a thread for each of subcompactions 1...num_threads-1
   std::vector<port::Thread> thread_pool;
   thread_pool.reserve(num_threads - 1);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
-                             &compact_->sub_compact_states[i]);
+  for (size_t i = 1; i < num_threads; i++) {
+    thread_pool.emplace_back(process_subcompactions, i);
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&compact_->sub_compact_states[0]);
+  process_subcompactions(0);
 
   // Wait for all other threads (if there are any) to finish execution
   for (auto& thread : thread_pool) {
@@ -2644,6 +2644,63 @@ INSTANTIATE_TEST_CASE_P(DBMultiGetAsyncIOTest, DBMultiGetAsyncIOTest,
                         testing::Bool());
 #endif  // USE_COROUTINES
 
+TEST_F(DBBasicTest, MultiGetAsyncIOPrefetchAcrossFiles) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions bbto;
+  bbto.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  Reopen(options);
+
+  // 4 non-overlapping files in L1, 8 keys each
+  for (int i = 0; i < 32; ++i) {
+    ASSERT_OK(Put(Key(i), "val_" + std::to_string(i)));
+    if (i % 8 == 7) {
+      ASSERT_OK(Flush());
+    }
+  }
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,4", FilesPerLevel());
+
+  size_t max_lookups = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "Version::MultiGetFromSSTsWithPrefetch:NumLookups", [&](void* arg) {
+        max_lookups = std::max(max_lookups, *static_cast<size_t*>(arg));
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<std::string> key_strs;
+  std::vector<Slice> keys;
+  for (int i = 1; i < 34; i += 4) {
+    key_strs.push_back(Key(i));
+  }
+  for (const auto& key : key_strs) {
+    keys.emplace_back(key);
+  }
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+  ReadOptions ro;
+  ro.async_io = true;
+  dbfull()->MultiGet(ro, dbfull()->DefaultColumnFamily(), keys.size(),
+                     keys.data(), values.data(), statuses.data());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    int key_num = 1 + static_cast<int>(i) * 4;
+    if (key_num < 32) {
+      ASSERT_OK(statuses[i]);
+      ASSERT_EQ(values[i], "val_" + std::to_string(key_num));
+    } else {
+      ASSERT_TRUE(statuses[i].IsNotFound());
+    }
+  }
+#ifndef USE_COROUTINES
+  // All the files of L1 were filtered before any of them was read
+  ASSERT_EQ(max_lookups, 4U);
+#endif  // USE_COROUTINES
+}
+
 TEST_F(DBBasicTest, MultiGetStats) {
   Options options;
   options.create_if_missing = true;
@@ -5930,6 +5930,55 @@ INSTANTIATE_TEST_CASE_P(RoundRobinSubcompactionsAgainstResources,
                                           std::make_tuple(5, 10),
                                           std::make_tuple(10, 10)));
 
+TEST_F(DBCompactionTest, SubcompactionRangesPerThread) {
+  const int kKeysPerBuffer = 100;
+  Options options = CurrentOptions();
+  options.num_levels = 3;
+  options.target_file_size_base = kKeysPerBuffer * 1024;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 2;
+  options.subcompaction_ranges_per_thread = 4;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int lvl = 2; lvl > 0; lvl--) {
+    for (int i = 0; i < 10; i++) {
+      for (int j = 0; j < kKeysPerBuffer; j++) {
+        ASSERT_OK(Put(Key(2 * i * kKeysPerBuffer + 2 * j + (lvl - 1)),
+                      rnd.RandomString(1010)));
+      }
+      ASSERT_OK(Flush());
+    }
+    MoveFilesToLevel(lvl);
+  }
+
+  uint64_t num_threads = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::GenSubcompactionBoundaries:1",
+      [&](void* arg) { num_threads = *static_cast<uint64_t*>(arg); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // The input was split into more ranges than the 2 threads that ran them
+  ASSERT_EQ(num_threads, 2);
+  HistogramData num_sub_compactions;
+  options.statistics->histogramData(NUM_SUBCOMPACTIONS_SCHEDULED,
+                                    &num_sub_compactions);
+  ASSERT_GT(num_sub_compactions.max, 2);
+  ASSERT_LE(num_sub_compactions.max, 8);
+
+  for (int i = 0; i < 20 * kKeysPerBuffer; i++) {
+    ASSERT_NE("NOT_FOUND", Get(Key(i)));
+  }
+}
+
 TEST_P(DBCompactionTestWithParam, RoundRobinWithoutAdditionalResources) {
   const int kKeysPerBuffer = 200;
   Options options = CurrentOptions();
@@ -2160,6 +2160,68 @@ TEST_F(DBFlushTest, FlushWithBlob) {
                 compaction_stats[0].bytes_written_blob);
 }
 
+TEST_F(DBFlushTest, ParallelCompressionWriteFailure) {
+  if (mem_env_ || encrypted_env_) {
+    ROCKSDB_GTEST_SKIP("Test requires non-mem or non-encrypted environment");
+    return;
+  }
+  // A write error stops the write thread of a table builder with parallel
+  // compression while blocks are still being compressed on the shared
+  // compression pool. The builder is abandoned and must not be destroyed
+  // before their compression jobs return.
+  std::shared_ptr<FaultInjectionTestFS> fault_fs(
+      new FaultInjectionTestFS(FileSystem::Default()));
+  std::unique_ptr<Env> fault_fs_env(NewCompositeEnv(fault_fs));
+  Options options = CurrentOptions();
+  options.env = fault_fs_env.get();
+  options.disable_auto_compactions = true;
+  options.compression_opts.parallel_threads = 4;
+  // Let the file system see the failed write soon after it is injected
+  options.writable_file_max_buffer_size = 1024;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  constexpr int kNumKeys = 1000;
+  Random rnd(301);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(100)));
+  }
+
+  std::atomic<int> num_blocks_written{0};
+  std::atomic<bool> write_failed{false};
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlockBasedTableBuilder::WriteMaybeCompressedBlock:TamperWithChecksum",
+      [&](void*) {
+        if (++num_blocks_written == 10) {
+          fault_fs->SetFilesystemActive(false,
+                                        IOStatus::IOError("Injected error"));
+          write_failed = true;
+        }
+      });
+  // Keep the blocks emitted around the failure in the compression jobs
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlockBasedTableBuilder::BGWorkCompression", [&](void*) {
+        if (write_failed) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_NOK(Flush());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_TRUE(write_failed);
+
+  // The keys are recovered from the WAL
+  fault_fs->SetFilesystemActive(true);
+  Reopen(options);
+  for (int i = 0; i < kNumKeys; i += 100) {
+    ASSERT_NE("NOT_FOUND", Get(Key(i)));
+  }
+  Close();
+}
+
 TEST_F(DBFlushTest, FlushWithChecksumHandoff1) {
   if (mem_env_ || encrypted_env_) {
     ROCKSDB_GTEST_SKIP("Test requires non-mem or non-encrypted environment");
@@ -297,6 +297,11 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   if (immutable_db_options_.use_spdb_writes) {
     spdb_write_.reset(new SpdbWriteImpl(this));
   }
+
+  if (write_controller_->is_dynamic_delay()) {
+    write_controller_->RegisterWriter(
+        &immutable_db_options_, immutable_db_options_.write_controller_weight);
+  }
 }
 
 Status DBImpl::Resume() {
@@ -702,6 +707,9 @@ Status DBImpl::CloseHelper() {
   // versions need to be destroyed before table_cache since it can hold
   // references to table_cache.
   versions_.reset();
+  if (write_controller_->is_dynamic_delay()) {
+    write_controller_->DeregisterWriter(&immutable_db_options_);
+  }
   mutex_.Unlock();
   if (db_lock_ != nullptr) {
     // TODO: Check for unlock error
@@ -1086,26 +1086,43 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     } else {
       reporter.status = &status;
     }
+    TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
+                             /*arg=*/nullptr);
     // We intentially make log::Reader do checksumming even if
     // paranoid_checks==false so that corruptions cause entire commits
     // to be skipped instead of propagating bad information (like overly
     // large sequence numbers).
-    log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
-                       &reporter, true /*checksum*/, wal_number);
+    std::unique_ptr<log::Reader> reader;
+    std::unique_ptr<log::ReadAheadReader> read_ahead_reader;
+    if (immutable_db_options_.enable_pipelined_wal_recovery) {
+      // Starts reading the WAL, so it's created after the sync point above
+      constexpr size_t kMaxReadAheadBytes = 8 << 20;
+      read_ahead_reader.reset(new log::ReadAheadReader(
+          immutable_db_options_.info_log, std::move(file_reader), &reporter,
+          true /*checksum*/, wal_number,
+          immutable_db_options_.wal_recovery_mode, kMaxReadAheadBytes));
+    } else {
+      reader.reset(new log::Reader(immutable_db_options_.info_log,
+                                   std::move(file_reader), &reporter,
+                                   true /*checksum*/, wal_number));
+    }
+    auto read_record = [&](Slice* record, std::string* scratch,
+                           uint64_t* record_checksum) {
+      if (read_ahead_reader) {
+        return read_ahead_reader->ReadRecord(record, scratch, record_checksum);
+      }
+      return reader->ReadRecord(record, scratch,
+                                immutable_db_options_.wal_recovery_mode,
+                                record_checksum);
+    };
 
     // Determine if we should tolerate incomplete records at the tail end of the
     // Read all the records and add to a memtable
     std::string scratch;
     Slice record;
-
-    TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
-                             /*arg=*/nullptr);
     uint64_t record_checksum;
     while (!stop_replay_by_wal_filter &&
-           reader.ReadRecord(&record, &scratch,
-                             immutable_db_options_.wal_recovery_mode,
-                             &record_checksum) &&
-           status.ok()) {
+           read_record(&record, &scratch, &record_checksum) && status.ok()) {
       if (record.size() < WriteBatchInternal::kHeader) {
         reporter.Corruption(record.size(),
                             Status::Corruption("log record too small"));
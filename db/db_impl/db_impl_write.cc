@@ -1819,7 +1819,8 @@ Status DBImpl::DelayWrite(uint64_t num_bytes, WriteThread& write_thread,
     uint64_t delay;
     if (&write_thread == &write_thread_) {
       delay =
-          write_controller_->GetDelay(immutable_db_options_.clock, num_bytes);
+          write_controller_->GetDelay(immutable_db_options_.clock, num_bytes,
+                                     &immutable_db_options_);
     } else {
       assert(num_bytes == 0);
       delay = 0;
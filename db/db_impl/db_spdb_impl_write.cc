@@ -41,36 +41,50 @@ bool WritesBatchList::Add(WriteBatch* batch, const WriteOptions& write_options,
     need_sync_ = true;
   }
   if (elements_num_ == 1) {
-    // first wal batch . should take the buffer_write_rw_lock_ as write
+    // first batch of the group. it will write the group to the wal
     *leader_batch = true;
-    buffer_write_rw_lock_.WriteLock();
   }
-  write_ref_rwlock_.ReadLock();
+  pending_memtable_writes_.fetch_add(1, std::memory_order_relaxed);
   return switch_wb_.load();
 }
 
+void WritesBatchList::MemtableWriteDone() {
+  if (pending_memtable_writes_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    MutexLock l(&state_mutex_);
+    state_cv_.SignalAll();
+  }
+}
+
 void WritesBatchList::WriteBatchComplete(bool leader_batch) {
   // Batch was added to the memtable, we can release the memtable_ref.
-  write_ref_rwlock_.ReadUnlock();
+  MemtableWriteDone();
   if (leader_batch) {
-    {
-      // make sure all batches wrote to memtable (if needed) to be able progress
-      // the version
-      WriteLock wl(&write_ref_rwlock_);
-    }
-    complete_batch_.store(true);
+    // make sure all batches wrote to memtable (if needed) to be able progress
+    // the version
+    WaitForPendingWrites();
     // wal write has been completed wal waiters will be released
-    buffer_write_rw_lock_.WriteUnlock();
-  } else {
+    MutexLock l(&state_mutex_);
+    complete_batch_.store(true);
+    state_cv_.SignalAll();
+  } else if (!complete_batch_.load()) {
     // wait wal write completed
-    ReadLock rl(&buffer_write_rw_lock_);
+    MutexLock l(&state_mutex_);
+    while (!complete_batch_.load()) {
+      state_cv_.Wait();
+    }
   }
 }
 
 void WritesBatchList::WaitForPendingWrites() {
   // make sure all batches wrote to memtable (ifneeded) to be able progress the
   // version
-  WriteLock wl(&write_ref_rwlock_);
+  if (pending_memtable_writes_.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+  MutexLock l(&state_mutex_);
+  while (pending_memtable_writes_.load(std::memory_order_acquire) != 0) {
+    state_cv_.Wait();
+  }
 }
 
 void SpdbWriteImpl::WriteBatchComplete(void* list, bool leader_batch) {
@@ -433,20 +447,31 @@ void DBImpl::ResumeSpdbWrites() {
 IOStatus DBImpl::SpdbSyncWAL(uint64_t offset, uint64_t size) {
   IOStatus io_s;
   StopWatch sw(immutable_db_options_.clock, stats_, WAL_FILE_SYNC_MICROS);
+  log::Writer* log_writer = nullptr;
   {
     InstrumentedMutexLock l(&log_write_mutex_);
-    log::Writer* log_writer = logs_.back().writer;
+    log_writer = logs_.back().writer;
+    if (!log_writer->IsSyncRangeThreadSafe()) {
+      io_s =
+          log_writer->SyncRange(immutable_db_options_.use_fsync, offset, size);
+      log_writer = nullptr;
+    }
+  }
+  // Each batch group syncs only the range it appended, so the syncs of
+  // several groups may overlap with each other and with the appends of the
+  // following groups. The WAL can't be switched while a spdb write is in
+  // flight (see SuspendSpdbWrites()), so the writer stays valid here.
+  if (log_writer != nullptr) {
     io_s = log_writer->SyncRange(immutable_db_options_.use_fsync, offset, size);
-    /*ROCKS_LOG_INFO(immutable_db_options().info_log,
-                   "Complete SyncRange offset %" PRIu64 " size %" PRIu64,
-                   offset, size);*/
-  }
-  if (io_s.ok() && !log_dir_synced_) {
-    io_s = directories_.GetWalDir()->FsyncWithDirOptions(
-        IOOptions(), nullptr,
-        DirFsyncOptions(DirFsyncOptions::FsyncReason::kNewFileSynced));
-    log_dir_synced_ = true;
-    /*ROCKS_LOG_INFO(immutable_db_options().info_log, "Complete Sync dir");*/
+  }
+  if (io_s.ok()) {
+    InstrumentedMutexLock l(&log_write_mutex_);
+    if (!log_dir_synced_) {
+      io_s = directories_.GetWalDir()->FsyncWithDirOptions(
+          IOOptions(), nullptr,
+          DirFsyncOptions(DirFsyncOptions::FsyncReason::kNewFileSynced));
+      log_dir_synced_ = io_s.ok();
+    }
   }
   return io_s;
 }
@@ -23,6 +23,7 @@
 
 #include "port/port.h"
 #include "rocksdb/write_batch.h"
+#include "util/autovector.h"
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -31,11 +32,18 @@ class DBImpl;
 struct WriteOptions;
 
 struct WritesBatchList {
-  std::list<WriteBatch*> wal_writes_;
+  // The first batches are kept inline, so a typical batch group doesn't
+  // allocate on Add()
+  autovector<WriteBatch*, 16> wal_writes_;
   uint16_t elements_num_ = 0;
   uint64_t max_seq_ = 0;
-  port::RWMutexWr buffer_write_rw_lock_;
-  port::RWMutexWr write_ref_rwlock_;
+  // Number of batches that were added to the group and didn't complete their
+  // memtable write yet
+  std::atomic<uint32_t> pending_memtable_writes_{0};
+  // Used only for blocking until the pending memtable writes are done or
+  // until the leader completes the group's wal write
+  port::Mutex state_mutex_;
+  port::CondVar state_cv_{&state_mutex_};
   std::atomic<bool> need_sync_ = false;
   std::atomic<bool> switch_wb_ = false;
   std::atomic<bool> complete_batch_ = false;
@@ -56,6 +64,9 @@ struct WritesBatchList {
   bool IsSwitchWBOccur() const { return switch_wb_.load(); }
   bool IsComplete() const { return complete_batch_.load(); }
   void WriteBatchComplete(bool leader_batch);
+
+ private:
+  void MemtableWriteDone();
 };
 
 class SpdbWriteImpl {
@@ -13,6 +13,7 @@
 #include <limits>
 #include <string>
 
+#include "db/blob/blob_index.h"
 #include "db/dbformat.h"
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
@@ -82,6 +83,10 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       timestamp_ub_(read_options.timestamp),
       timestamp_lb_(read_options.iter_start_ts),
       timestamp_size_(timestamp_ub_ ? timestamp_ub_->size() : 0) {
+  if (read_options.blob_readahead_size > 0 && !expose_blob_index_) {
+    blob_prefetch_buffers_.reset(
+        new PrefetchBufferCollection(read_options.blob_readahead_size));
+  }
   RecordTick(statistics_, NO_ITERATOR_CREATED);
   if (pin_thru_lifetime_) {
     pinned_iters_mgr_.StartPinning();
@@ -200,11 +205,24 @@ bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
   read_options.fill_cache = fill_cache_;
   read_options.verify_checksums = verify_checksums_;
 
-  constexpr FilePrefetchBuffer* prefetch_buffer = nullptr;
-  constexpr uint64_t* bytes_read = nullptr;
+  BlobIndex blob_idx;
+  Status s = blob_idx.DecodeFrom(blob_index);
+
+  if (s.ok()) {
+    // Only forward scans read ahead, since a buffer prefetches the bytes that
+    // follow a read. Version::GetBlob() rejects the inlined and TTL blob
+    // indexes, which have no blob file.
+    FilePrefetchBuffer* prefetch_buffer = nullptr;
+    if (blob_prefetch_buffers_ && direction_ == kForward &&
+        !blob_idx.IsInlined() && !blob_idx.HasTTL()) {
+      prefetch_buffer = blob_prefetch_buffers_->GetOrCreatePrefetchBuffer(
+          blob_idx.file_number());
+    }
+    constexpr uint64_t* bytes_read = nullptr;
 
-  const Status s = version_->GetBlob(read_options, user_key, blob_index,
-                                     prefetch_buffer, &blob_value_, bytes_read);
+    s = version_->GetBlob(read_options, user_key, blob_idx, prefetch_buffer,
+                          &blob_value_, bytes_read);
+  }
 
   if (!s.ok()) {
     status_ = s;
@@ -1585,6 +1603,51 @@ void DBIter::SeekForPrev(const Slice& target) {
   }
 }
 
+void DBIter::SeekMany(const std::vector<Slice>& targets,
+                      const std::function<bool(size_t)>& callback) {
+  for (size_t i = 0; i < targets.size(); ++i) {
+    assert(i == 0 || timestamp_size_ > 0 ||
+           user_comparator_.Compare(targets[i - 1], targets[i]) <= 0);
+    if (!NextToSeekTarget(targets[i])) {
+      Seek(targets[i]);
+    }
+    if (!callback(i)) {
+      break;
+    }
+  }
+}
+
+bool DBIter::NextToSeekTarget(const Slice& target) {
+  // The number of entries after the current key that are checked before
+  // falling back to a seek. A Next() only advances the child iterator at the
+  // top of the heap, while a Seek() seeks all of them.
+  static constexpr int kMaxNextsToSeekTarget = 8;
+
+  // In prefix mode, the inner iterator may skip the keys of other prefixes
+  if (!valid_ || !status_.ok() || direction_ != kForward ||
+      !expect_total_order_inner_iter_ || prefix_same_as_start_ ||
+      timestamp_size_ > 0) {
+    return false;
+  }
+  if (user_comparator_.Compare(key(), target) >= 0) {
+    // The target is at or before the current key, it may be any of the keys
+    // already passed
+    return false;
+  }
+  for (int i = 0; i < kMaxNextsToSeekTarget; ++i) {
+    Next();
+    if (!valid_) {
+      // All the keys up to the end (or the upper bound) are before target, so
+      // a seek would be invalid too
+      return status_.ok();
+    }
+    if (user_comparator_.Compare(key(), target) >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void DBIter::SeekToFirst() {
   if (iterate_lower_bound_ != nullptr) {
     Seek(*iterate_lower_bound_);
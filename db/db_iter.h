@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <string>
 
+#include "db/blob/prefetch_buffer_collection.h"
 #include "db/db_impl/db_impl.h"
 #include "db/range_del_aggregator.h"
 #include "memory/arena.h"
@@ -203,6 +204,8 @@ class DBIter final : public Iterator {
   void SeekForPrev(const Slice& target) final override;
   void SeekToFirst() final override;
   void SeekToLast() final override;
+  void SeekMany(const std::vector<Slice>& targets,
+                const std::function<bool(size_t)>& callback) final override;
   Env* env() const { return env_; }
   void set_sequence(uint64_t s) {
     sequence_ = s;
@@ -227,6 +230,10 @@ class DBIter final : public Iterator {
   // It might get adjusted if the seek key is larger than iterator upper bound.
   // target does not have timestamp.
   void SetSavedKeyToSeekForPrevTarget(const Slice& target);
+  // Positions the iterator at target with up to kMaxNextsToSeekTarget Next()
+  // calls, if target is after the current key. Returns false if the iterator
+  // still needs to seek to target.
+  bool NextToSeekTarget(const Slice& target);
   bool FindValueForCurrentKey();
   bool FindValueForCurrentKeyUsingSeek();
   bool FindUserKeyBeforeSavedKey();
@@ -343,6 +350,8 @@ class DBIter final : public Iterator {
   Slice pinned_value_;
   // for prefix seek mode to support prev()
   PinnableSlice blob_value_;
+  // Readahead buffers of the blob files, per ReadOptions::blob_readahead_size
+  std::unique_ptr<PrefetchBufferCollection> blob_prefetch_buffers_;
   // Value of the default column
   Slice value_;
   // All columns (i.e. name-value pairs)
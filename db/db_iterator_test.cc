@@ -238,6 +238,61 @@ std::string MakeLongKey(size_t length, char c) {
 }
 }  // anonymous namespace
 
+TEST_P(DBIteratorTest, SeekMany) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  // Even keys, half of them in an SST file and half in the memtable
+  for (int i = 0; i < 200; i += 2) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+    if (i == 100) {
+      ASSERT_OK(Flush());
+    }
+  }
+
+  // Targets close to each other, far from each other, and past the end
+  std::vector<std::string> target_keys;
+  for (int i : {1, 2, 9, 17, 25, 50, 51, 57, 120, 121, 133, 190, 199, 250}) {
+    target_keys.push_back(Key(i));
+  }
+  std::vector<Slice> targets(target_keys.begin(), target_keys.end());
+
+  std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+  std::unique_ptr<Iterator> expected_iter(NewIterator(ReadOptions()));
+  uint64_t num_seeks_before =
+      options.statistics->getTickerCount(NUMBER_DB_SEEK);
+  size_t num_called = 0;
+  iter->SeekMany(targets, [&](size_t i) {
+    EXPECT_EQ(i, num_called++);
+    expected_iter->Seek(targets[i]);
+    // Read the target and the entry after it, like a short scan would
+    for (int j = 0; j < 2 && expected_iter->Valid(); ++j) {
+      EXPECT_TRUE(iter->Valid());
+      if (!iter->Valid()) {
+        return false;
+      }
+      EXPECT_EQ(expected_iter->key(), iter->key());
+      EXPECT_EQ(expected_iter->value(), iter->value());
+      expected_iter->Next();
+      iter->Next();
+    }
+    EXPECT_EQ(expected_iter->Valid(), iter->Valid());
+    return true;
+  });
+  ASSERT_EQ(num_called, targets.size());
+  ASSERT_OK(iter->status());
+  // The targets just ahead of the previous ones were reached without a seek
+  ASSERT_LT(options.statistics->getTickerCount(NUMBER_DB_SEEK) -
+                num_seeks_before,
+            2 * targets.size());
+
+  // Stopping the batch
+  num_called = 0;
+  iter->SeekMany(targets, [&](size_t /*i*/) { return ++num_called < 3; });
+  ASSERT_EQ(num_called, 3);
+}
+
 TEST_P(DBIteratorTest, IterLongKeys) {
   ASSERT_OK(Put(MakeLongKey(20, 0), "0"));
   ASSERT_OK(Put(MakeLongKey(32, 2), "2"));
@@ -3,15 +3,21 @@
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
 
 #include "db/db_test_util.h"
 #include "db/memtable.h"
 #include "db/range_del_aggregator.h"
+#include "plugin/speedb/memtable/hash_spd_rep.h"
+#include "plugin/speedb/memtable/sharded_skiplist_rep.h"
 #include "port/stack_trace.h"
 #include "rocksdb/memtablerep.h"
 #include "rocksdb/slice_transform.h"
+#include "util/random.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -335,6 +341,185 @@ TEST_F(DBMemTableTest, ColumnFamilyId) {
   }
 }
 
+TEST_F(DBMemTableTest, HashSpdRepIteratorAfterRunsMerge) {
+  // Creating iterators switches the sorted vectors of the memtable, and the
+  // sort thread merges the sorted vectors in the background. The iterators
+  // must see all the keys in order while this happens.
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_factory.reset(new HashSpdRepFactory(1000));
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 35000;
+  constexpr int kKeysBetweenIterators = 1000;
+  std::vector<int> key_ids(kNumKeys);
+  std::iota(key_ids.begin(), key_ids.end(), 0);
+  RandomShuffle(key_ids.begin(), key_ids.end());
+  std::vector<std::unique_ptr<Iterator>> iters;
+  int min_key_id = kNumKeys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(key_ids[i]), "v" + std::to_string(key_ids[i])));
+    min_key_id = std::min(min_key_id, key_ids[i]);
+    if (i % kKeysBetweenIterators == 0) {
+      iters.emplace_back(db_->NewIterator(ReadOptions()));
+      iters.back()->SeekToFirst();
+      ASSERT_TRUE(iters.back()->Valid());
+      ASSERT_EQ(Key(min_key_id), iters.back()->key().ToString());
+    }
+  }
+
+  for (int round = 0; round < 2; ++round) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int expected = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+      ASSERT_EQ("v" + std::to_string(expected), iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, expected);
+
+    iter->Seek(Key(kNumKeys / 2));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(kNumKeys / 2), iter->key().ToString());
+    iter->Prev();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(kNumKeys / 2 - 1), iter->key().ToString());
+
+    expected = kNumKeys - 1;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), --expected) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+    }
+    ASSERT_EQ(-1, expected);
+    // let the sort thread merge the runs before the second round
+    env_->SleepForMicroseconds(100000);
+  }
+
+  // the old iterators still see their snapshot of the memtable
+  for (auto& old_iter : iters) {
+    int count = 0;
+    for (old_iter->SeekToFirst(); old_iter->Valid(); old_iter->Next()) {
+      ++count;
+    }
+    ASSERT_OK(old_iter->status());
+    ASSERT_LE(1, count);
+  }
+}
+
+TEST_F(DBMemTableTest, ShardedSkipListRep) {
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_factory.reset(new ShardedSkipListRepFactory(4));
+  DestroyAndReopen(options);
+
+  // Spread the inserts over the shards regardless of the cores the threads
+  // run on, and let Allocate() and Insert() of the same key use different
+  // shards
+  std::atomic<int> next_shard{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "ShardedSkipListRep::CurrentShard",
+      [&](void* arg) { *static_cast<int*>(arg) = next_shard++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 4000;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      // every key is written by the kNumThreads / 2 threads with the same
+      // parity, i.e. 4 times
+      for (int i = t % 2; i < kNumKeys; i += 2) {
+        ASSERT_OK(Put(Key(i), "v" + std::to_string(t)));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  auto verify = [&]() {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int expected = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+      ASSERT_EQ(iter->value().ToString(), Get(Key(expected)));
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, expected);
+
+    // switch directions in the middle
+    iter->Seek(Key(kNumKeys / 2));
+    ASSERT_TRUE(iter->Valid());
+    iter->Prev();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(kNumKeys / 2 - 1), iter->key().ToString());
+    iter->Next();
+    iter->Next();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(kNumKeys / 2 + 1), iter->key().ToString());
+
+    expected = kNumKeys - 1;
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), --expected) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+    }
+    ASSERT_EQ(-1, expected);
+  };
+
+  verify();
+  ASSERT_GE(next_shard.load(), 2 * kNumKeys * kNumThreads / 2);
+  ASSERT_OK(Flush());
+  verify();
+}
+
+TEST_F(DBMemTableTest, ShardedSkipListRepFactoryFromString) {
+  const size_t kDefaultNumShards =
+      std::min(size_t{std::max(std::thread::hardware_concurrency(), 1U)},
+               size_t{ShardedSkipListRepFactory::kMaxNumShards});
+  const std::string kId =
+      std::string("id=") + ShardedSkipListRepFactory::kClassName();
+  ConfigOptions config_options;
+  std::shared_ptr<MemTableRepFactory> factory;
+
+  ASSERT_OK(MemTableRepFactory::CreateFromString(
+      config_options, kId + ";num_shards=0", &factory));
+  auto* sharded = factory->CheckedCast<ShardedSkipListRepFactory>();
+  ASSERT_NE(sharded, nullptr);
+  ASSERT_EQ(sharded->GetNumShards(), kDefaultNumShards);
+
+  ASSERT_OK(MemTableRepFactory::CreateFromString(
+      config_options, kId + ";num_shards=1000", &factory));
+  sharded = factory->CheckedCast<ShardedSkipListRepFactory>();
+  ASSERT_NE(sharded, nullptr);
+  ASSERT_EQ(sharded->GetNumShards(), ShardedSkipListRepFactory::kMaxNumShards);
+  ASSERT_OK(factory->ValidateOptions(DBOptions(), ColumnFamilyOptions()));
+
+  // Without PrepareOptions() too many shards are rejected, and the memtables
+  // still get a shard per hardware thread for 0
+  config_options.invoke_prepare_options = false;
+  ASSERT_OK(MemTableRepFactory::CreateFromString(
+      config_options, kId + ";num_shards=1000", &factory));
+  ASSERT_NOK(factory->ValidateOptions(DBOptions(), ColumnFamilyOptions()));
+  ASSERT_OK(MemTableRepFactory::CreateFromString(
+      config_options, kId + ";num_shards=0", &factory));
+  sharded = factory->CheckedCast<ShardedSkipListRepFactory>();
+  ASSERT_NE(sharded, nullptr);
+  ASSERT_EQ(sharded->GetNumShards(), size_t{0});
+  ASSERT_OK(factory->ValidateOptions(DBOptions(), ColumnFamilyOptions()));
+
+  Options options = CurrentOptions();
+  options.memtable_factory = factory;
+  DestroyAndReopen(options);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(Get(Key(i)), "v" + std::to_string(i));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get(Key(0)), "v0");
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -1446,6 +1446,106 @@ TEST_F(DBSSTTest, OpenDBWithInfiniteMaxOpenFiles) {
   }
 }
 
+TEST_F(DBSSTTest, PinTableReadersUpToHalfTableCache) {
+  for (bool pin_up_to_half_table_cache : {false, true}) {
+    Options options;
+    options.create_if_missing = true;
+    options.write_buffer_size = 100000;
+    options.disable_auto_compactions = true;
+    // 16 entries per table cache shard
+    options.max_open_files = 1000;
+    options.pin_table_readers_up_to_half_table_cache =
+        pin_up_to_half_table_cache;
+    options = CurrentOptions(options);
+    DestroyAndReopen(options);
+
+    // More files than loaded on DB open by default
+    for (int i = 0; i < 24; i++) {
+      std::string k = Key(i);
+      ASSERT_OK(Put(k, k + std::string(1000, 'a')));
+      ASSERT_OK(Flush());
+    }
+    Close();
+
+    Reopen(options);
+    std::vector<std::vector<FileMetaData>> files;
+    dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+    int num_files = 0;
+    int num_pinned = 0;
+    for (const auto& level : files) {
+      for (const auto& file : level) {
+        ++num_files;
+        if (file.table_reader_handle != nullptr) {
+          ASSERT_NE(file.fd.table_reader, nullptr);
+          ++num_pinned;
+        }
+      }
+    }
+    ASSERT_EQ(num_files, 24);
+    if (pin_up_to_half_table_cache) {
+      ASSERT_EQ(num_pinned, num_files);
+    } else {
+      ASSERT_LT(num_pinned, num_files);
+    }
+
+    for (int i = 0; i < 24; i++) {
+      ASSERT_EQ(Get(Key(i)), Key(i) + std::string(1000, 'a'));
+    }
+  }
+}
+
+TEST_F(DBSSTTest, PinTableReadersLeavesRoomForUnpinnedFiles) {
+  Options options;
+  options.create_if_missing = true;
+  options.write_buffer_size = 100000;
+  options.disable_auto_compactions = true;
+  options.level0_slowdown_writes_trigger = 200;
+  options.level0_stop_writes_trigger = 200;
+  // A table cache of 128 files, in the default 64 shards of 2 files
+  options.max_open_files = 138;
+  ASSERT_EQ(options.table_cache_numshardbits, 6);
+  options.pin_table_readers_up_to_half_table_cache = true;
+  options.statistics = CreateDBStatistics();
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // More files than max_open_files
+  constexpr int kNumFiles = 150;
+  for (int i = 0; i < kNumFiles; i++) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  Close();
+
+  Reopen(options);
+  std::vector<std::vector<FileMetaData>> files;
+  dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+  std::vector<std::string> unpinned_keys;
+  int num_pinned = 0;
+  for (const auto& level : files) {
+    for (const auto& file : level) {
+      if (file.table_reader_handle != nullptr) {
+        ++num_pinned;
+      } else {
+        unpinned_keys.push_back(file.smallest.user_key().ToString());
+      }
+    }
+  }
+  // At most one file per shard
+  ASSERT_GT(num_pinned, 0);
+  ASSERT_LE(num_pinned, 64);
+  ASSERT_EQ(unpinned_keys.size(), kNumFiles - num_pinned);
+
+  // Every file that is not pinned stays in the other half of its shard once
+  // it is opened
+  for (const auto& key : unpinned_keys) {
+    ASSERT_NE(Get(key), "NOT_FOUND");
+    uint64_t num_opens = TestGetTickerCount(options, NO_FILE_OPENS);
+    ASSERT_NE(Get(key), "NOT_FOUND");
+    ASSERT_EQ(TestGetTickerCount(options, NO_FILE_OPENS), num_opens);
+  }
+}
+
 TEST_F(DBSSTTest, OpenDBWithInfiniteMaxOpenFilesSubjectToMemoryLimit) {
   for (CacheEntryRoleOptions::Decision charge_table_reader :
        {CacheEntryRoleOptions::Decision::kEnabled,
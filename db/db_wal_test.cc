@@ -1076,6 +1076,33 @@ TEST_F(DBWALTest, RecoverWithLargeLog) {
   } while (ChangeWalOptions());
 }
 
+TEST_F(DBWALTest, PipelinedWalRecovery) {
+  Options options = CurrentOptions();
+  options.avoid_flush_during_recovery = true;
+  options.enable_pipelined_wal_recovery = true;
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  // Each reopen keeps the WALs, so the last one recovers several WALs, with
+  // values larger than the read ahead buffer
+  Random rnd(301);
+  std::vector<std::map<std::string, std::string>> expected(2);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 100; ++i) {
+      int cf = i % 2;
+      std::string key = Key(round * 100 + i);
+      std::string value = rnd.RandomString(i % 10 == 0 ? (1 << 20) : 100);
+      ASSERT_OK(Put(cf, key, value));
+      expected[cf][key] = value;
+    }
+    ReopenWithColumnFamilies({"default", "pikachu"}, options);
+    for (int cf = 0; cf < 2; ++cf) {
+      for (const auto& kv : expected[cf]) {
+        ASSERT_EQ(kv.second, Get(cf, kv.first));
+      }
+    }
+  }
+}
+
 // In https://reviews.facebook.net/D20661 we change
 // recovery behavior: previously for each log file each column family
 // memtable was flushed, even it was empty. Now it's changed:
@@ -1384,9 +1411,10 @@ class RecoveryTestHelper {
   }
 };
 
-class DBWALTestWithParams : public DBWALTestBase,
-                            public ::testing::WithParamInterface<
-                                std::tuple<bool, int, int, CompressionType>> {
+class DBWALTestWithParams
+    : public DBWALTestBase,
+      public ::testing::WithParamInterface<
+          std::tuple<bool, int, int, CompressionType, bool>> {
  public:
   DBWALTestWithParams() : DBWALTestBase("/db_wal_test_with_params") {}
 };
@@ -1399,7 +1427,9 @@ INSTANTIATE_TEST_CASE_P(
                                             RecoveryTestHelper::kWALFilesCount,
                                         1),
                        ::testing::Values(CompressionType::kNoCompression,
-                                         CompressionType::kZSTD)));
+                                         CompressionType::kZSTD),
+                       // enable_pipelined_wal_recovery
+                       ::testing::Bool()));
 
 class DBWALTestWithParamsVaryingRecoveryMode
     : public DBWALTestBase,
@@ -1437,6 +1467,7 @@ TEST_P(DBWALTestWithParams, kTolerateCorruptedTailRecords) {
 
   // Fill data for testing
   Options options = CurrentOptions();
+  options.enable_pipelined_wal_recovery = std::get<4>(GetParam());
   const size_t row_count = RecoveryTestHelper::FillData(this, &options);
   // test checksum failure or parsing
   RecoveryTestHelper::CorruptWAL(this, options, corrupt_offset * .3,
@@ -1460,6 +1491,7 @@ TEST_P(DBWALTestWithParams, kTolerateCorruptedTailRecords) {
 TEST_P(DBWALTestWithParams, kAbsoluteConsistency) {
   // Verify clean slate behavior
   Options options = CurrentOptions();
+  options.enable_pipelined_wal_recovery = std::get<4>(GetParam());
   const size_t row_count = RecoveryTestHelper::FillData(this, &options);
   options.create_if_missing = false;
   ASSERT_OK(TryReopen(options));
@@ -1713,6 +1745,7 @@ TEST_P(DBWALTestWithParams, kPointInTimeRecovery) {
 
   // Fill data for testing
   Options options = CurrentOptions();
+  options.enable_pipelined_wal_recovery = std::get<4>(GetParam());
   options.wal_compression = compression_type;
   const size_t row_count = RecoveryTestHelper::FillData(this, &options);
 
@@ -1770,6 +1803,7 @@ TEST_P(DBWALTestWithParams, kSkipAnyCorruptedRecords) {
 
   // Fill data for testing
   Options options = CurrentOptions();
+  options.enable_pipelined_wal_recovery = std::get<4>(GetParam());
   options.wal_compression = compression_type;
   const size_t row_count = RecoveryTestHelper::FillData(this, &options);
 
@@ -1791,6 +1825,70 @@ TEST_P(DBWALTestWithParams, kSkipAnyCorruptedRecords) {
   }
 }
 
+// Test scope:
+// - Pipelined recovery of a WAL with a corrupted record in its middle,
+// followed by more records and more WALs, opens (or fails to open) the data
+// store and recovers exactly the same keys as recovery without pipelining
+TEST_F(DBWALTest, PipelinedWalRecoveryOfCorruptedWal) {
+  const int kNumKeys =
+      RecoveryTestHelper::kWALFilesCount * RecoveryTestHelper::kKeysPerWALFile;
+  const int kCorruptedWal = RecoveryTestHelper::kWALFileOffset + 4;
+
+  for (WALRecoveryMode mode : {WALRecoveryMode::kTolerateCorruptedTailRecords,
+                               WALRecoveryMode::kAbsoluteConsistency,
+                               WALRecoveryMode::kPointInTimeRecovery,
+                               WALRecoveryMode::kSkipAnyCorruptedRecords}) {
+    Status statuses[2];
+    std::vector<bool> found[2];
+    for (bool pipelined : {false, true}) {
+      Options options = CurrentOptions();
+      RecoveryTestHelper::FillData(this, &options);
+      RecoveryTestHelper::CorruptWAL(this, options, /*off=*/.5, /*len%=*/.1,
+                                     kCorruptedWal);
+
+      options.wal_recovery_mode = mode;
+      options.enable_pipelined_wal_recovery = pipelined;
+      options.create_if_missing = false;
+      statuses[pipelined] = TryReopen(options);
+      if (statuses[pipelined].ok()) {
+        for (int k = 0; k < kNumKeys; ++k) {
+          found[pipelined].push_back(Get("key" + std::to_string(k)) !=
+                                     "NOT_FOUND");
+        }
+      }
+    }
+    ASSERT_EQ(statuses[0].code(), statuses[1].code());
+    ASSERT_EQ(found[0], found[1]);
+
+    size_t recovered = std::count(found[1].begin(), found[1].end(), true);
+    const size_t keys_before_corrupted_wal =
+        RecoveryTestHelper::kKeysPerWALFile *
+        (kCorruptedWal - RecoveryTestHelper::kWALFileOffset);
+    switch (mode) {
+      case WALRecoveryMode::kTolerateCorruptedTailRecords:
+      case WALRecoveryMode::kAbsoluteConsistency:
+        ASSERT_NOK(statuses[1]);
+        break;
+      case WALRecoveryMode::kPointInTimeRecovery:
+        // Stops at the corrupted record
+        ASSERT_OK(statuses[1]);
+        ASSERT_GT(recovered, keys_before_corrupted_wal);
+        ASSERT_LT(recovered, keys_before_corrupted_wal +
+                                 RecoveryTestHelper::kKeysPerWALFile);
+        for (size_t k = 0; k < recovered; ++k) {
+          ASSERT_TRUE(found[1][k]);
+        }
+        break;
+      case WALRecoveryMode::kSkipAnyCorruptedRecords:
+        // Skips the corrupted records only
+        ASSERT_OK(statuses[1]);
+        ASSERT_LT(recovered, static_cast<size_t>(kNumKeys));
+        ASSERT_TRUE(found[1].back());
+        break;
+    }
+  }
+}
+
 TEST_F(DBWALTest, AvoidFlushDuringRecovery) {
   Options options = CurrentOptions();
   options.disable_auto_compactions = true;
@@ -20,6 +20,7 @@
 #include "util/string_util.h"
 #include "utilities/fault_injection_env.h"
 #include "utilities/fault_injection_fs.h"
+#include "utilities/merge_operators.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -775,6 +776,74 @@ TEST_P(DBWriteTest, ConcurrentlyDisabledWAL) {
   ASSERT_LE(bytes_num, 1024 * 100);
 }
 
+TEST_F(DBWriteTestUnparameterized, SpdbConcurrentSyncWrites) {
+  Options options = CurrentOptions();
+  options.use_spdb_writes = true;
+  options.allow_concurrent_memtable_write = true;
+  Reopen(options);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeysPerThread = 100;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([t, this]() {
+      WriteOptions wo;
+      wo.sync = true;
+      for (int i = 0; i < kNumKeysPerThread; i++) {
+        ASSERT_OK(Put(Key(t * kNumKeysPerThread + i), std::to_string(i), wo));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // All the synced writes must be recovered from the WAL
+  Reopen(options);
+  for (int t = 0; t < kNumThreads; t++) {
+    for (int i = 0; i < kNumKeysPerThread; i++) {
+      ASSERT_EQ(std::to_string(i), Get(Key(t * kNumKeysPerThread + i)));
+    }
+  }
+}
+
+TEST_F(DBWriteTestUnparameterized, SpdbConcurrentWritesWithMerge) {
+  Options options = CurrentOptions();
+  options.use_spdb_writes = true;
+  options.allow_concurrent_memtable_write = true;
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  Reopen(options);
+
+  constexpr int kNumThreads = 16;
+  constexpr int kNumWritesPerThread = 200;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([t, this]() {
+      for (int i = 0; i < kNumWritesPerThread; i++) {
+        if (t % 4 == 0) {
+          ASSERT_OK(Merge("merge_key", "m"));
+        } else {
+          ASSERT_OK(Put(Key(t * kNumWritesPerThread + i), "v"));
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  std::string merged = Get("merge_key");
+  ASSERT_EQ(static_cast<size_t>(kNumThreads / 4 * kNumWritesPerThread * 2 - 1),
+            merged.size());
+  for (int t = 0; t < kNumThreads; t++) {
+    if (t % 4 != 0) {
+      for (int i = 0; i < kNumWritesPerThread; i++) {
+        ASSERT_EQ("v", Get(Key(t * kNumWritesPerThread + i)));
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(DBWriteTestInstance, DBWriteTest,
                         testing::Values(DBTestBase::kDefault,
                                         DBTestBase::kConcurrentWALWrites,
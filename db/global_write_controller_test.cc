@@ -26,7 +26,8 @@ class GlobalWriteControllerTest : public DBTestBase {
   ~GlobalWriteControllerTest() { CloseAndDeleteDBs(); }
 
   void OpenDBsAndSetUp(int num_dbs, Options& options, bool add_wbm = false,
-                       uint64_t buffer_size = 40_kb) {
+                       uint64_t buffer_size = 40_kb,
+                       bool weighted_fair_delay = false) {
     db_names_.clear();
     for (int i = 0; i < num_dbs; i++) {
       dbs_.push_back(nullptr);
@@ -38,8 +39,11 @@ class GlobalWriteControllerTest : public DBTestBase {
     options.level0_stop_writes_trigger = 20;
     options.delayed_write_rate = 16_mb;
     options.use_dynamic_delay = true;
-    options.write_controller.reset(new WriteController(
-        options.use_dynamic_delay, options.delayed_write_rate));
+    options.write_controller.reset(
+        new WriteController(options.use_dynamic_delay,
+                            options.delayed_write_rate,
+                            1024 * 1024 /*low_pri_rate_bytes_per_sec*/,
+                            weighted_fair_delay));
     if (add_wbm) {
       options.write_buffer_manager.reset(new WriteBufferManager(
           buffer_size, {}, true /*allow_stall*/, false /*initiate_flushes*/,
@@ -49,6 +53,10 @@ class GlobalWriteControllerTest : public DBTestBase {
 
     for (int i = 0; i < num_dbs; i++) {
       ASSERT_OK(DestroyDB(db_names_[i], options));
+      if (weighted_fair_delay) {
+        // db i gets a weight of i + 1
+        options.write_controller_weight = i + 1;
+      }
       ASSERT_OK(DB::Open(options, db_names_[i], &(dbs_[i])));
     }
 
@@ -568,6 +576,62 @@ TEST_F(GlobalWriteControllerTest, GlobalAndWBMStressTest) {
   }
 }
 
+// test weighted fair delay:
+// the delay requests of a db's own column families only delay that db, while
+// the requests that aren't owned by a db are split according to the weights.
+TEST_F(GlobalWriteControllerTest, WeightedFairDelay) {
+  Options options = CurrentOptions();
+  int num_dbs = 2;
+  OpenDBsAndSetUp(num_dbs, options, false /*add_wbm*/, 40_kb,
+                  true /*weighted_fair_delay*/);
+  auto wc = options.write_controller;
+  ASSERT_TRUE(wc->is_weighted_fair_delay());
+
+  for (int i = 0; i < num_dbs; i++) {
+    ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[i]->immutable_db_options())
+                  .delayed_write_rate,
+              0U);
+  }
+
+  SetL0delayAndRecalcConditions(0 /*db_idx*/, 15 /*l0_files*/);
+  auto l0_rate = CalcL0Delay(15, options, wc->max_delayed_write_rate());
+  ASSERT_TRUE(IsDbWriteDelayed(dbimpls_[0]));
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[0]->immutable_db_options())
+                .delayed_write_rate,
+            l0_rate);
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[1]->immutable_db_options())
+                .delayed_write_rate,
+            0U);
+  // the db that isn't delayed doesn't pay for the delay of the other one
+  ASSERT_EQ(wc->GetDelay(env_->GetSystemClock().get(), 1_mb,
+                         &dbimpls_[1]->immutable_db_options()),
+            0U);
+  ASSERT_GT(wc->GetDelay(env_->GetSystemClock().get(), 1_mb,
+                         &dbimpls_[0]->immutable_db_options()),
+            0U);
+
+  // a shared request (e.g. the wbm) is split 1:2 between the dbs
+  uint64_t shared_rate = 6_mb;
+  wc->HandleNewDelayReq(this, shared_rate);
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[0]->immutable_db_options())
+                .delayed_write_rate,
+            std::min(l0_rate, shared_rate / 3));
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[1]->immutable_db_options())
+                .delayed_write_rate,
+            shared_rate * 2 / 3);
+
+  wc->HandleRemoveDelayReq(this);
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[1]->immutable_db_options())
+                .delayed_write_rate,
+            0U);
+
+  SetL0delayAndRecalcConditions(0 /*db_idx*/, 5 /*l0_files*/);
+  ASSERT_EQ(wc->GetWriterDelayStats(&dbimpls_[0]->immutable_db_options())
+                .delayed_write_rate,
+            0U);
+  ASSERT_FALSE(IsDbWriteDelayed(dbimpls_[0]));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
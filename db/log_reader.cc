@@ -17,6 +17,7 @@
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace log {
@@ -852,5 +853,105 @@ bool FragmentBufferedReader::TryReadFragment(
   }
 }
 
+ReadAheadReader::ReadAheadReader(std::shared_ptr<Logger> info_log,
+                                 std::unique_ptr<SequentialFileReader>&& file,
+                                 Reader::Reporter* reporter, bool checksum,
+                                 uint64_t log_num,
+                                 WALRecoveryMode wal_recovery_mode,
+                                 size_t max_buffered_bytes)
+    : reporter_(reporter),
+      queueing_reporter_(this),
+      reader_(info_log, std::move(file), &queueing_reporter_, checksum,
+              log_num),
+      wal_recovery_mode_(wal_recovery_mode),
+      max_buffered_bytes_(max_buffered_bytes),
+      cv_(&mutex_) {
+  thread_ = port::Thread([this]() { ReadAhead(); });
+}
+
+ReadAheadReader::~ReadAheadReader() {
+  {
+    MutexLock l(&mutex_);
+    stopped_ = true;
+    cv_.SignalAll();
+  }
+  thread_.join();
+}
+
+void ReadAheadReader::QueueingReporter::Corruption(size_t bytes,
+                                                   const Status& status) {
+  Entry entry;
+  entry.kind = Entry::kCorruption;
+  entry.dropped_bytes = bytes;
+  entry.status = status;
+  owner_->Push(std::move(entry));
+}
+
+bool ReadAheadReader::Push(Entry&& entry) {
+  MutexLock l(&mutex_);
+  // Corruptions are reported by the Reader, they don't wait for room
+  while (entry.kind == Entry::kRecord && !stopped_ &&
+         buffered_bytes_ >= max_buffered_bytes_) {
+    cv_.Wait();
+  }
+  if (stopped_) {
+    return false;
+  }
+  buffered_bytes_ += entry.record.size();
+  entries_.push_back(std::move(entry));
+  cv_.SignalAll();
+  return true;
+}
+
+void ReadAheadReader::ReadAhead() {
+  std::string scratch;
+  Slice record;
+  uint64_t record_checksum = 0;
+  while (reader_.ReadRecord(&record, &scratch, wal_recovery_mode_,
+                            &record_checksum)) {
+    Entry entry;
+    entry.kind = Entry::kRecord;
+    entry.record.assign(record.data(), record.size());
+    entry.record_checksum = record_checksum;
+    if (!Push(std::move(entry))) {
+      return;
+    }
+  }
+  Entry entry;
+  entry.kind = Entry::kEnd;
+  Push(std::move(entry));
+}
+
+bool ReadAheadReader::ReadRecord(Slice* record, std::string* scratch,
+                                 uint64_t* record_checksum) {
+  MutexLock l(&mutex_);
+  while (true) {
+    while (entries_.empty()) {
+      cv_.Wait();
+    }
+    Entry& entry = entries_.front();
+    if (entry.kind == Entry::kEnd) {
+      // Left in the queue for the next calls
+      return false;
+    }
+    if (entry.kind == Entry::kCorruption) {
+      if (reporter_ != nullptr) {
+        reporter_->Corruption(entry.dropped_bytes, entry.status);
+      }
+      entries_.pop_front();
+      continue;
+    }
+    scratch->swap(entry.record);
+    *record = Slice(*scratch);
+    if (record_checksum != nullptr) {
+      *record_checksum = entry.record_checksum;
+    }
+    buffered_bytes_ -= scratch->size();
+    entries_.pop_front();
+    cv_.SignalAll();
+    return true;
+  }
+}
+
 }  // namespace log
 }  // namespace ROCKSDB_NAMESPACE
@@ -10,10 +10,13 @@
 #pragma once
 #include <stdint.h>
 
+#include <deque>
 #include <memory>
+#include <string>
 
 #include "db/log_format.h"
 #include "file/sequence_file_reader.h"
+#include "port/port.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/status.h"
@@ -221,5 +224,67 @@ class FragmentBufferedReader : public Reader {
   void operator=(const FragmentBufferedReader&);
 };
 
+// Reads the records of a log with a Reader on a background thread, up to
+// max_buffered_bytes ahead of ReadRecord(), so that reading the log and
+// verifying its checksums overlaps with the processing of its records.
+// The corruptions found by the background thread are reported to the
+// reporter by ReadRecord(), in their order in the log, as a Reader would.
+class ReadAheadReader {
+ public:
+  ReadAheadReader(std::shared_ptr<Logger> info_log,
+                  std::unique_ptr<SequentialFileReader>&& file,
+                  Reader::Reporter* reporter, bool checksum, uint64_t log_num,
+                  WALRecoveryMode wal_recovery_mode, size_t max_buffered_bytes);
+  // No copying allowed
+  ReadAheadReader(const ReadAheadReader&) = delete;
+  void operator=(const ReadAheadReader&) = delete;
+
+  // Stops reading ahead
+  ~ReadAheadReader();
+
+  // Same as Reader::ReadRecord()
+  bool ReadRecord(Slice* record, std::string* scratch,
+                  uint64_t* record_checksum = nullptr);
+
+ private:
+  // Queues the corruptions for ReadRecord()
+  class QueueingReporter : public Reader::Reporter {
+   public:
+    explicit QueueingReporter(ReadAheadReader* owner) : owner_(owner) {}
+    void Corruption(size_t bytes, const Status& status) override;
+
+   private:
+    ReadAheadReader* const owner_;
+  };
+
+  struct Entry {
+    enum Kind { kRecord, kCorruption, kEnd };
+    Kind kind;
+    std::string record;
+    uint64_t record_checksum = 0;
+    size_t dropped_bytes = 0;
+    Status status;
+  };
+
+  // The background thread
+  void ReadAhead();
+
+  // Returns false if the reader is stopped
+  bool Push(Entry&& entry);
+
+  Reader::Reporter* const reporter_;
+  QueueingReporter queueing_reporter_;
+  Reader reader_;
+  const WALRecoveryMode wal_recovery_mode_;
+  const size_t max_buffered_bytes_;
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  std::deque<Entry> entries_;
+  size_t buffered_bytes_ = 0;
+  bool stopped_ = false;
+  port::Thread thread_;
+};
+
 }  // namespace log
 }  // namespace ROCKSDB_NAMESPACE
@@ -178,6 +178,10 @@ IOStatus Writer::SyncRange(bool use_fsync, uint64_t offset, uint64_t size) {
   return s;
 }
 
+bool Writer::IsSyncRangeThreadSafe() const {
+  return !manual_flush_ && dest_->writable_file()->IsSyncThreadSafe();
+}
+
 IOStatus Writer::AddCompressionTypeRecord() {
   // Should be the first record
   assert(block_offset_ == 0);
@@ -92,6 +92,10 @@ class Writer {
       uint64_t* size = nullptr);
 
   IOStatus SyncRange(bool use_fsync, uint64_t offset, uint64_t size);
+  // Returns true if SyncRange() may be called without external
+  // synchronization against concurrent AddRecord() calls, i.e. the records
+  // are flushed to the file on append and the file supports concurrent syncs.
+  bool IsSyncRangeThreadSafe() const;
   IOStatus AddCompressionTypeRecord();
 
   WritableFileWriter* file() { return dest_.get(); }
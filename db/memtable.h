@@ -44,6 +44,7 @@ struct ImmutableMemTableOptions {
   explicit ImmutableMemTableOptions(const ImmutableOptions& ioptions,
                                     const MutableCFOptions& mutable_cf_options);
   size_t arena_block_size;
+  bool memtable_grow_arena_blocks;
   uint32_t memtable_prefix_bloom_bits;
   size_t memtable_huge_page_size;
   bool memtable_whole_key_filtering;
@@ -9,6 +9,10 @@
 
 #include "db/table_cache.h"
 
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
 #include "db/dbformat.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "db/snapshot_impl.h"
@@ -29,6 +33,8 @@
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
 #include "util/coding.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
 #include "util/stop_watch.h"
 
 // Generate the regular and coroutine versions of some methods by
@@ -60,6 +66,37 @@ void AppendVarint64(IterKey* key, uint64_t v) {
   key->TrimAppend(key->Size(), buf, ptr - buf);
 }
 
+// Returns the admission sketch of row_cache, shared by the table caches of
+// all the column families (and DBs) that use it, so that a row cache pays
+// for a single sketch however many column families it serves
+std::shared_ptr<FrequencySketch> GetRowCacheAdmissionSketch(Cache* row_cache) {
+  using SketchMap =
+      std::unordered_map<const Cache*, std::weak_ptr<FrequencySketch>>;
+  STATIC_AVOID_DESTRUCTION(port::Mutex, mutex);
+  STATIC_AVOID_DESTRUCTION(SketchMap, sketches);
+
+  MutexLock l(&mutex);
+  std::shared_ptr<FrequencySketch> sketch = sketches[row_cache].lock();
+  if (sketch == nullptr) {
+    // The sketches of the caches that were destroyed expired, and a new
+    // cache may reuse the address of one of them
+    for (auto it = sketches.begin(); it != sketches.end();) {
+      if (it->second.expired()) {
+        it = sketches.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    // About a counter per 64 bytes of row cache, bounding the sketch to
+    // 128KB
+    size_t num_counters = std::min<size_t>(
+        std::max<size_t>(row_cache->GetCapacity() / 64, 1 << 12), 1 << 18);
+    sketch = std::make_shared<FrequencySketch>(num_counters);
+    sketches[row_cache] = sketch;
+  }
+  return sketch;
+}
+
 }  // anonymous namespace
 
 const int kLoadConcurency = 128;
@@ -80,7 +117,14 @@ TableCache::TableCache(const ImmutableOptions& ioptions,
   if (ioptions_.row_cache) {
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
-    PutVarint64(&row_cache_id_, ioptions_.row_cache->NewId());
+    uint64_t row_cache_id = ioptions_.row_cache->NewId();
+    PutVarint64(&row_cache_id_, row_cache_id);
+    if (ioptions_.row_cache_frequency_admission) {
+      row_cache_admission_ =
+          GetRowCacheAdmissionSketch(ioptions_.row_cache.get());
+      // The same key of different column families counts separately
+      row_cache_admission_seed_ = row_cache_id;
+    }
   }
 }
 
@@ -398,6 +442,14 @@ bool TableCache::GetFromRowCache(const Slice& user_key, IterKey& row_cache_key,
   return found;
 }
 
+bool TableCache::AdmitToRowCache(const Slice& user_key) {
+  if (row_cache_admission_ == nullptr) {
+    return true;
+  }
+  return row_cache_admission_->Record(
+             GetSliceNPHash64(user_key, row_cache_admission_seed_)) >= 2;
+}
+
 Status TableCache::Get(
     const ReadOptions& options,
     const InternalKeyComparator& internal_comparator,
@@ -469,7 +521,8 @@ Status TableCache::Get(
   }
 
   // Put the replay log in row cache only if something was found.
-  if (!done && s.ok() && row_cache_entry && !row_cache_entry->empty()) {
+  if (!done && s.ok() && row_cache_entry && !row_cache_entry->empty() &&
+      AdmitToRowCache(ExtractUserKey(k))) {
     RowCacheInterface row_cache{ioptions_.row_cache.get()};
     size_t charge = row_cache_entry->capacity() + sizeof(std::string);
     auto row_ptr = new std::string(std::move(*row_cache_entry));
@@ -506,6 +559,19 @@ void TableCache::UpdateRangeTombstoneSeqnums(
   }
 }
 
+void TableCache::PrefetchMultiGetDataBlocks(
+    const ReadOptions& options, const FileMetaData& file_meta,
+    const std::shared_ptr<const SliceTransform>& prefix_extractor,
+    const MultiGetContext::Range* mget_range, TypedHandle* table_handle) {
+  TableReader* t = file_meta.fd.table_reader;
+  if (t == nullptr && table_handle != nullptr) {
+    t = cache_.Value(table_handle);
+  }
+  if (t != nullptr && !mget_range->empty()) {
+    t->PrefetchMultiGetDataBlocks(options, mget_range, prefix_extractor.get());
+  }
+}
+
 Status TableCache::MultiGetFilter(
     const ReadOptions& options,
     const InternalKeyComparator& internal_comparator,
@@ -634,6 +700,12 @@ void TableCache::Evict(Cache* cache, uint64_t file_number) {
   cache->Erase(GetSliceForFileNumber(&file_number));
 }
 
+bool TableCache::IsOverHalfOfShardPinned(uint64_t file_number) const {
+  Slice key = GetSliceForFileNumber(&file_number);
+  return cache_.get()->GetShardPinnedUsage(key) >
+         cache_.get()->GetShardCapacity(key) / 2;
+}
+
 uint64_t TableCache::ApproximateOffsetOf(
     const Slice& key, const FileMetaData& file_meta, TableReaderCaller caller,
     const InternalKeyComparator& internal_comparator,
@@ -11,6 +11,7 @@
 
 #pragma once
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include "table/table_reader.h"
 #include "trace_replay/block_cache_tracer.h"
 #include "util/coro_utils.h"
+#include "util/frequency_sketch.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -98,6 +100,14 @@ class TableCache {
       const InternalKey* largest_compaction_key, bool allow_unprepared_value,
       TruncatedRangeDelIterator** range_del_iter = nullptr);
 
+  // Call table reader's PrefetchMultiGetDataBlocks() to start reading the data
+  // blocks of the keys in mget_range. table_handle is the handle returned by
+  // MultiGetFilter(), if any. Does nothing if the table reader isn't open.
+  void PrefetchMultiGetDataBlocks(
+      const ReadOptions& options, const FileMetaData& file_meta,
+      const std::shared_ptr<const SliceTransform>& prefix_extractor,
+      const MultiGetContext::Range* mget_range, TypedHandle* table_handle);
+
   // If a seek to internal key "k" in specified file finds an entry,
   // call get_context->SaveValue() repeatedly until
   // it returns false. As a side effect, it will insert the TableReader
@@ -158,6 +168,10 @@ class TableCache {
   // Evict any entry for the specified file number
   static void Evict(Cache* cache, uint64_t file_number);
 
+  // Whether more than half of the capacity of the table cache shard that
+  // holds the table reader of the specified file number is pinned
+  bool IsOverHalfOfShardPinned(uint64_t file_number) const;
+
   // Find table reader
   // @param skip_filters Disables loading/accessing the filter block
   // @param level == -1 means not specified
@@ -259,10 +273,18 @@ class TableCache {
   bool GetFromRowCache(const Slice& user_key, IterKey& row_cache_key,
                        size_t prefix_size, GetContext* get_context);
 
+  // Returns whether a row of the key that was read from a table should be
+  // inserted into the row cache. With row_cache_frequency_admission, records
+  // the read and admits the rows of the keys that were read recently.
+  bool AdmitToRowCache(const Slice& user_key);
+
   const ImmutableOptions& ioptions_;
   const FileOptions& file_options_;
   CacheInterface cache_;
   std::string row_cache_id_;
+  // Shared by all the table caches using the same row cache
+  std::shared_ptr<FrequencySketch> row_cache_admission_;
+  uint64_t row_cache_admission_seed_ = 0;
   bool immortal_tables_;
   BlockCacheTracer* const block_cache_tracer_;
   Striped<port::Mutex, Slice> loader_mutex_;
@@ -110,7 +110,7 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
       row_cache_key.TrimAppend(row_cache_key_prefix_size, user_key.data(),
                                user_key.size());
       // Put the replay log in row cache only if something was found.
-      if (s.ok() && !row_cache_entry.empty()) {
+      if (s.ok() && !row_cache_entry.empty() && AdmitToRowCache(user_key)) {
         size_t charge = row_cache_entry.capacity() + sizeof(std::string);
         auto row_ptr = new std::string(std::move(row_cache_entry));
         // If row cache is full, it's OK.
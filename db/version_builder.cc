@@ -1150,6 +1150,15 @@ class VersionBuilder::Rep {
     const auto& unordered_added_files = levels_[level].added_files;
     vstorage->Reserve(level, base_files.size() + unordered_added_files.size());
 
+    if (unordered_added_files.empty() && levels_[level].deleted_files.empty()) {
+      // Most levels are untouched by an edit, no need to look up each of their
+      // files in the added and deleted sets
+      for (auto* f : base_files) {
+        vstorage->AddFile(level, f);
+      }
+      return;
+    }
+
     // Sort added files for the level.
     std::vector<FileMetaData*> added_files;
     added_files.reserve(unordered_added_files.size());
@@ -1257,7 +1266,8 @@ class VersionBuilder::Rep {
       InternalStats* internal_stats, int max_threads,
       bool prefetch_index_and_filter_in_cache, bool is_initial_load,
       const std::shared_ptr<const SliceTransform>& prefix_extractor,
-      size_t max_file_size_for_l0_meta_pin) {
+      size_t max_file_size_for_l0_meta_pin,
+      bool pin_up_to_half_table_cache) {
     assert(table_cache_ != nullptr);
 
     size_t table_cache_capacity =
@@ -1277,7 +1287,16 @@ class VersionBuilder::Rep {
       // for those files. This doesn't matter much because if number of files
       // of the DB excceeds table cache capacity, eventually no table reader
       // will be pinned and LRU will be followed.
-      if (is_initial_load) {
+      //
+      // pin_up_to_half_table_cache trades a longer DB open for skipping
+      // the table cache on the reads of more files. Pinned handles are never
+      // evicted, so half of the table cache is left to the LRU of the files
+      // that are not pinned, which would otherwise be reopened on every read
+      // once the pinned files fill the cache. The table cache is sharded, so
+      // the files are not pinned either once half of their shard is pinned.
+      if (pin_up_to_half_table_cache) {
+        load_limit = table_cache_capacity / 2;
+      } else if (is_initial_load) {
         load_limit = std::min(kInitialLoadLimit, table_cache_capacity / 4);
       } else {
         load_limit = table_cache_capacity / 4;
@@ -1330,6 +1349,12 @@ class VersionBuilder::Rep {
             internal_stats->GetFileReadHist(level), false, level,
             prefetch_index_and_filter_in_cache, max_file_size_for_l0_meta_pin,
             file_meta->temperature);
+        if (handle != nullptr && pin_up_to_half_table_cache && !always_load &&
+            table_cache_->IsOverHalfOfShardPinned(file_meta->fd.GetNumber())) {
+          // Leave the rest of the shard to the files that are not pinned
+          table_cache_->get_cache().Release(handle);
+          handle = nullptr;
+        }
         if (handle != nullptr) {
           file_meta->table_reader_handle = handle;
           // Load table_reader
@@ -1384,10 +1409,11 @@ Status VersionBuilder::LoadTableHandlers(
     InternalStats* internal_stats, int max_threads,
     bool prefetch_index_and_filter_in_cache, bool is_initial_load,
     const std::shared_ptr<const SliceTransform>& prefix_extractor,
-    size_t max_file_size_for_l0_meta_pin) {
+    size_t max_file_size_for_l0_meta_pin, bool pin_up_to_half_table_cache) {
   return rep_->LoadTableHandlers(
       internal_stats, max_threads, prefetch_index_and_filter_in_cache,
-      is_initial_load, prefix_extractor, max_file_size_for_l0_meta_pin);
+      is_initial_load, prefix_extractor, max_file_size_for_l0_meta_pin,
+      pin_up_to_half_table_cache);
 }
 
 uint64_t VersionBuilder::GetMinOldestBlobFileNumber() const {
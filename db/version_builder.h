@@ -48,7 +48,8 @@ class VersionBuilder {
       InternalStats* internal_stats, int max_threads,
       bool prefetch_index_and_filter_in_cache, bool is_initial_load,
       const std::shared_ptr<const SliceTransform>& prefix_extractor,
-      size_t max_file_size_for_l0_meta_pin);
+      size_t max_file_size_for_l0_meta_pin,
+      bool pin_up_to_half_table_cache = false);
   uint64_t GetMinOldestBlobFileNumber() const;
 
  private:
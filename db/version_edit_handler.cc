@@ -569,7 +569,8 @@ Status VersionEditHandler::LoadTables(ColumnFamilyData* cfd,
       version_set_->db_options_->max_file_opening_threads,
       prefetch_index_and_filter_in_cache, is_initial_load,
       cfd->GetLatestMutableCFOptions()->prefix_extractor,
-      MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()));
+      MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()),
+      version_set_->db_options_->pin_table_readers_up_to_half_table_cache);
   if ((s.IsPathNotFound() || s.IsCorruption()) && no_error_if_files_missing_) {
     s = Status::OK();
   }
@@ -816,7 +817,8 @@ Status VersionEditHandlerPointInTime::MaybeCreateVersion(
         cfd->internal_stats(),
         version_set_->db_options_->max_file_opening_threads, false, true,
         cfd->GetLatestMutableCFOptions()->prefix_extractor,
-        MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()));
+        MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()),
+        version_set_->db_options_->pin_table_readers_up_to_half_table_cache);
     if (!s.ok()) {
       delete version;
       if (s.IsCorruption()) {
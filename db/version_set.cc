@@ -13,6 +13,7 @@
 #include <array>
 #include <cinttypes>
 #include <cstdio>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
@@ -2052,6 +2053,7 @@ VersionStorageInfo::VersionStorageInfo(
       base_level_(num_levels_ == 1 ? -1 : 1),
       level_multiplier_(0.0),
       files_by_compaction_pri_(num_levels_),
+      files_by_compaction_pri_reusable_(num_levels_, false),
       level0_non_overlapping_(false),
       next_file_to_compact_by_size_(num_levels_),
       compaction_score_(num_levels_),
@@ -2532,8 +2534,10 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       // Avoid using the coroutine version if we're looking in a L0 file, since
       // L0 files won't be parallelized anyway. The regular synchronous version
       // is faster.
-      if (!read_options.async_io || !using_coroutines() || !use_async_io_ ||
-          fp.GetHitFileLevel() == 0 || !fp.RemainingOverlapInLevel()) {
+      const bool batch_spans_files = read_options.async_io &&
+                                     fp.GetHitFileLevel() != 0 &&
+                                     fp.RemainingOverlapInLevel();
+      if (!batch_spans_files || (using_coroutines() && !use_async_io_)) {
         if (f) {
           bool skip_filters =
               IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
@@ -2551,6 +2555,13 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
         if (s.ok()) {
           f = fp.GetNextFileInLevel();
         }
+      } else if (!using_coroutines()) {
+        // The files of the level are looked up one after the other. Filter the
+        // keys of all of them first, and let the file system start reading
+        // their data blocks, so that the reads of the files overlap.
+        s = MultiGetFromSSTsWithPrefetch(read_options, &fp, &f, blob_ctxs,
+                                         num_filter_read, num_index_read,
+                                         num_sst_read);
 #if USE_COROUTINES
       } else {
         std::vector<folly::coro::Task<Status>> mget_tasks;
@@ -2719,6 +2730,83 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
   }
 }
 
+Status Version::MultiGetFromSSTsWithPrefetch(
+    const ReadOptions& read_options, FilePickerMultiGet* fp,
+    FdWithKeyRange** f,
+    std::unordered_map<uint64_t, BlobReadContexts>& blob_ctxs,
+    uint64_t& num_filter_read, uint64_t& num_index_read,
+    uint64_t& num_sst_read) {
+  struct FileLookup {
+    FdWithKeyRange* file;
+    MultiGetRange file_range;
+    TableCache::TypedHandle* table_handle;
+    bool skip_filters;
+    bool skip_range_deletions;
+  };
+  autovector<FileLookup, 4> lookups;
+  const int level = static_cast<int>(fp->GetHitFileLevel());
+  Status s;
+  while (*f != nullptr) {
+    MultiGetRange file_range = fp->CurrentFileRange();
+    TableCache::TypedHandle* table_handle = nullptr;
+    bool skip_filters = IsFilterSkipped(level, fp->IsHitFileLastInLevel());
+    bool skip_range_deletions = false;
+    bool filtered = false;
+    if (!skip_filters) {
+      Status status = table_cache_->MultiGetFilter(
+          read_options, *internal_comparator(), *(*f)->file_metadata,
+          mutable_cf_options_.prefix_extractor,
+          cfd_->internal_stats()->GetFileReadHist(level), level, &file_range,
+          &table_handle);
+      skip_range_deletions = true;
+      if (status.ok()) {
+        skip_filters = true;
+        filtered = true;
+      } else if (!status.IsNotSupported()) {
+        s = status;
+      }
+    }
+    if (!s.ok()) {
+      break;
+    }
+
+    if (!file_range.empty()) {
+      if (filtered) {
+        table_cache_->PrefetchMultiGetDataBlocks(
+            read_options, *(*f)->file_metadata,
+            mutable_cf_options_.prefix_extractor, &file_range, table_handle);
+      }
+      lookups.push_back({*f, file_range, table_handle, skip_filters,
+                         skip_range_deletions});
+    }
+    if (fp->KeyMaySpanNextFile()) {
+      break;
+    }
+    *f = fp->GetNextFileInLevel();
+  }
+
+  size_t num_lookups = lookups.size();
+  TEST_SYNC_POINT_CALLBACK("Version::MultiGetFromSSTsWithPrefetch:NumLookups",
+                           &num_lookups);
+  // Like the coroutine version, all the files that were filtered are looked
+  // up (which also releases their table handles), and the first error is
+  // returned
+  for (auto& lookup : lookups) {
+    Status status = MultiGetFromSST(
+        read_options, lookup.file_range, level, lookup.skip_filters,
+        lookup.skip_range_deletions, lookup.file, blob_ctxs,
+        lookup.table_handle, num_filter_read, num_index_read, num_sst_read);
+    if (s.ok() && !status.ok()) {
+      s = std::move(status);
+    }
+  }
+
+  if (s.ok() && *f != nullptr && fp->KeyMaySpanNextFile()) {
+    *f = fp->GetNextFileInLevel();
+  }
+  return s;
+}
+
 #ifdef USE_COROUTINES
 Status Version::ProcessBatch(
     const ReadOptions& read_options, FilePickerMultiGet* batch,
@@ -2968,11 +3056,13 @@ void VersionStorageInfo::GenerateLevelFilesBrief() {
 
 void VersionStorageInfo::PrepareForVersionAppend(
     const ImmutableOptions& immutable_options,
-    const MutableCFOptions& mutable_cf_options) {
+    const MutableCFOptions& mutable_cf_options,
+    const VersionStorageInfo* ref_vstorage) {
   ComputeCompensatedSizes();
   UpdateNumNonEmptyLevels();
   CalculateBaseBytes(immutable_options, mutable_cf_options);
-  UpdateFilesByCompactionPri(immutable_options, mutable_cf_options);
+  UpdateFilesByCompactionPri(immutable_options, mutable_cf_options,
+                             ref_vstorage);
   GenerateFileIndexer();
   GenerateLevelFilesBrief();
   GenerateLevel0NonOverlapping();
@@ -2992,7 +3082,14 @@ void Version::PrepareAppend(const MutableCFOptions& mutable_cf_options,
     UpdateAccumulatedStats();
   }
 
-  storage_info_.PrepareForVersionAppend(*cfd_->ioptions(), mutable_cf_options);
+  // The current version is the base of (almost) every new version, so most of
+  // its levels are unchanged in this one
+  const Version* current = cfd_->current();
+  const VersionStorageInfo* ref_vstorage =
+      (current != nullptr && current != this) ? current->storage_info()
+                                              : nullptr;
+  storage_info_.PrepareForVersionAppend(*cfd_->ioptions(), mutable_cf_options,
+                                        ref_vstorage);
 }
 
 bool Version::MaybeInitializeFileMetaData(FileMetaData* file_meta) {
@@ -3437,7 +3534,8 @@ void VersionStorageInfo::ComputeCompactionScore(
       mutable_cf_options.blob_garbage_collection_force_threshold < 1.0) {
     ComputeFilesMarkedForForcedBlobGC(
         mutable_cf_options.blob_garbage_collection_age_cutoff,
-        mutable_cf_options.blob_garbage_collection_force_threshold);
+        mutable_cf_options.blob_garbage_collection_force_threshold,
+        mutable_cf_options.blob_garbage_collection_force_max_batches);
   }
 
   EstimateCompactionBytesNeeded(mutable_cf_options);
@@ -3551,7 +3649,8 @@ void VersionStorageInfo::ComputeFilesMarkedForPeriodicCompaction(
 
 void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     double blob_garbage_collection_age_cutoff,
-    double blob_garbage_collection_force_threshold) {
+    double blob_garbage_collection_force_threshold,
+    uint32_t blob_garbage_collection_force_max_batches) {
   files_marked_for_forced_blob_gc_.clear();
 
   if (blob_files_.empty()) {
@@ -3595,38 +3694,62 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
   // blob_garbage_collection_force_threshold and the entire batch has to be
   // eligible for GC according to blob_garbage_collection_age_cutoff in order
   // for us to schedule any compactions.
-  const auto& oldest_meta = blob_files_.front();
-  assert(oldest_meta);
-
-  const auto& linked_ssts = oldest_meta->GetLinkedSsts();
-  assert(!linked_ssts.empty());
+  //
+  // If the oldest batch doesn't have enough garbage, the next batches may be
+  // added to it, up to blob_garbage_collection_force_max_batches batches: any
+  // SST that relies on a blob file of the oldest N batches is linked to one of
+  // them, so compacting the linked SSTs of the N batches gets rid of all of
+  // their blob files. In the example above, the two batches are blob files
+  // {10, 11} and {12, 13}, and compacting SSTs 1, 2, and 3 gets rid of them.
+  uint64_t sum_total_blob_bytes = 0;
+  uint64_t sum_garbage_blob_bytes = 0;
+  std::vector<const BlobFileMetaData::LinkedSsts*> batches_linked_ssts;
+
+  size_t count = 0;
+  while (batches_linked_ssts.size() <
+             blob_garbage_collection_force_max_batches &&
+         count < cutoff_count) {
+    const auto& batch_meta = blob_files_[count];
+    assert(batch_meta);
+
+    const auto& linked_ssts = batch_meta->GetLinkedSsts();
+    assert(!linked_ssts.empty());
+
+    uint64_t batch_total_blob_bytes = batch_meta->GetTotalBlobBytes();
+    uint64_t batch_garbage_blob_bytes = batch_meta->GetGarbageBlobBytes();
+
+    assert(cutoff_count <= blob_files_.size());
+
+    for (++count; count < cutoff_count; ++count) {
+      const auto& meta = blob_files_[count];
+      assert(meta);
 
-  size_t count = 1;
-  uint64_t sum_total_blob_bytes = oldest_meta->GetTotalBlobBytes();
-  uint64_t sum_garbage_blob_bytes = oldest_meta->GetGarbageBlobBytes();
+      if (!meta->GetLinkedSsts().empty()) {
+        // Found the beginning of the next batch of blob files
+        break;
+      }
 
-  assert(cutoff_count <= blob_files_.size());
+      batch_total_blob_bytes += meta->GetTotalBlobBytes();
+      batch_garbage_blob_bytes += meta->GetGarbageBlobBytes();
+    }
 
-  for (; count < cutoff_count; ++count) {
-    const auto& meta = blob_files_[count];
-    assert(meta);
+    if (count < blob_files_.size()) {
+      const auto& meta = blob_files_[count];
+      assert(meta);
 
-    if (!meta->GetLinkedSsts().empty()) {
-      // Found the beginning of the next batch of blob files
-      break;
+      if (meta->GetLinkedSsts().empty()) {
+        // Some files in this batch are not eligible for GC
+        return;
+      }
     }
 
-    sum_total_blob_bytes += meta->GetTotalBlobBytes();
-    sum_garbage_blob_bytes += meta->GetGarbageBlobBytes();
-  }
-
-  if (count < blob_files_.size()) {
-    const auto& meta = blob_files_[count];
-    assert(meta);
+    batches_linked_ssts.push_back(&linked_ssts);
+    sum_total_blob_bytes += batch_total_blob_bytes;
+    sum_garbage_blob_bytes += batch_garbage_blob_bytes;
 
-    if (meta->GetLinkedSsts().empty()) {
-      // Some files in the oldest batch are not eligible for GC
-      return;
+    if (sum_garbage_blob_bytes >=
+        blob_garbage_collection_force_threshold * sum_total_blob_bytes) {
+      break;
     }
   }
 
@@ -3635,23 +3758,25 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
     return;
   }
 
-  for (uint64_t sst_file_number : linked_ssts) {
-    const FileLocation location = GetFileLocation(sst_file_number);
-    assert(location.IsValid());
+  for (const auto* linked_ssts : batches_linked_ssts) {
+    for (uint64_t sst_file_number : *linked_ssts) {
+      const FileLocation location = GetFileLocation(sst_file_number);
+      assert(location.IsValid());
 
-    const int level = location.GetLevel();
-    assert(level >= 0);
+      const int level = location.GetLevel();
+      assert(level >= 0);
 
-    const size_t pos = location.GetPosition();
+      const size_t pos = location.GetPosition();
 
-    FileMetaData* const sst_meta = files_[level][pos];
-    assert(sst_meta);
+      FileMetaData* const sst_meta = files_[level][pos];
+      assert(sst_meta);
 
-    if (sst_meta->being_compacted) {
-      continue;
-    }
+      if (sst_meta->being_compacted) {
+        continue;
+      }
 
-    files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
+      files_marked_for_forced_blob_gc_.emplace_back(level, sst_meta);
+    }
   }
 }
 
@@ -3745,13 +3870,14 @@ void VersionStorageInfo::UpdateNumNonEmptyLevels() {
 }
 
 namespace {
-// Sort `temp` based on ratio of overlapping size over file size
-void SortFileByOverlappingRatio(
+// Calls `score_file(file, overlapping_bytes, ttl_boost_score)` for each of
+// `files`, with the total size of the files of `next_level_files` that
+// overlap it, and its FileTtlBooster score (1 when TTL is disabled)
+template <typename ScoreFn>
+void ScoreFilesByNextLevelOverlap(
     const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
     const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
-    int level, int num_non_empty_levels, uint64_t ttl,
-    std::vector<Fsize>* temp) {
-  std::unordered_map<uint64_t, uint64_t> file_to_order;
+    int level, int num_non_empty_levels, uint64_t ttl, ScoreFn score_file) {
   auto next_level_it = next_level_files.begin();
 
   int64_t curr_time;
@@ -3786,31 +3912,84 @@ void SortFileByOverlappingRatio(
     uint64_t ttl_boost_score = (ttl > 0) ? ttl_booster.GetBoostScore(file) : 1;
     assert(ttl_boost_score > 0);
     assert(file->compensated_file_size != 0);
-    file_to_order[file->fd.GetNumber()] = overlapping_bytes * 1024U /
-                                          file->compensated_file_size /
-                                          ttl_boost_score;
+    score_file(file, overlapping_bytes, ttl_boost_score);
   }
+}
 
+// Partially sort `temp` so that its first kNumberFilesToSort files are the
+// ones whose score in `file_to_score` comes first by `comes_first`
+template <typename Score, typename Compare>
+void PartialSortFilesByScore(
+    const InternalKeyComparator& icmp,
+    std::unordered_map<uint64_t, Score>& file_to_score, Compare comes_first,
+    std::vector<Fsize>* temp) {
   size_t num_to_sort = temp->size() > VersionStorageInfo::kNumberFilesToSort
                            ? VersionStorageInfo::kNumberFilesToSort
                            : temp->size();
 
   std::partial_sort(temp->begin(), temp->begin() + num_to_sort, temp->end(),
                     [&](const Fsize& f1, const Fsize& f2) -> bool {
+                      const Score& score1 =
+                          file_to_score[f1.file->fd.GetNumber()];
+                      const Score& score2 =
+                          file_to_score[f2.file->fd.GetNumber()];
                       // If score is the same, pick file with smaller keys.
                       // This makes the algorithm more deterministic, and also
                       // help the trivial move case to have more files to
                       // extend.
-                      if (file_to_order[f1.file->fd.GetNumber()] ==
-                          file_to_order[f2.file->fd.GetNumber()]) {
+                      if (score1 == score2) {
                         return icmp.Compare(f1.file->smallest,
                                             f2.file->smallest) < 0;
                       }
-                      return file_to_order[f1.file->fd.GetNumber()] <
-                             file_to_order[f2.file->fd.GetNumber()];
+                      return comes_first(score1, score2);
                     });
 }
 
+// Sort `temp` based on ratio of overlapping size over file size
+void SortFileByOverlappingRatio(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
+    int level, int num_non_empty_levels, uint64_t ttl,
+    std::vector<Fsize>* temp) {
+  std::unordered_map<uint64_t, uint64_t> file_to_order;
+  ScoreFilesByNextLevelOverlap(
+      icmp, files, next_level_files, clock, level, num_non_empty_levels, ttl,
+      [&](FileMetaData* file, uint64_t overlapping_bytes,
+          uint64_t ttl_boost_score) {
+        file_to_order[file->fd.GetNumber()] = overlapping_bytes * 1024U /
+                                              file->compensated_file_size /
+                                              ttl_boost_score;
+      });
+  PartialSortFilesByScore(icmp, file_to_order, std::less<uint64_t>(), temp);
+}
+
+// Sort `temp` based on the read benefit of compacting each file over the
+// bytes rewritten by the compaction, highest first
+void SortFileByReadAmpBenefit(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
+    int level, int num_non_empty_levels, uint64_t ttl,
+    std::vector<Fsize>* temp) {
+  std::unordered_map<uint64_t, double> file_to_benefit;
+  ScoreFilesByNextLevelOverlap(
+      icmp, files, next_level_files, clock, level, num_non_empty_levels, ttl,
+      [&](FileMetaData* file, uint64_t overlapping_bytes,
+          uint64_t ttl_boost_score) {
+        // Bytes rewritten per byte of the file moved to the next level
+        const double write_amp =
+            static_cast<double>(file->compensated_file_size +
+                                overlapping_bytes) /
+            static_cast<double>(file->compensated_file_size);
+        // Every sampled read of the file would have one less level to search
+        const double read_benefit =
+            1.0 + static_cast<double>(file->stats.num_reads_sampled.load(
+                      std::memory_order_relaxed));
+        file_to_benefit[file->fd.GetNumber()] =
+            read_benefit * static_cast<double>(ttl_boost_score) / write_amp;
+      });
+  PartialSortFilesByScore(icmp, file_to_benefit, std::greater<double>(), temp);
+}
+
 void SortFileByRoundRobin(const InternalKeyComparator& icmp,
                           std::vector<InternalKey>* compact_cursor,
                           bool level0_non_overlapping, int level,
@@ -3867,8 +4046,30 @@ void SortFileByRoundRobin(const InternalKeyComparator& icmp,
 }
 }  // anonymous namespace
 
+bool VersionStorageInfo::CanReuseFilesByCompactionPri(
+    const ImmutableOptions& ioptions, const VersionStorageInfo* ref_vstorage,
+    int level) const {
+  if (ref_vstorage == nullptr || !ref_vstorage->finalized_ ||
+      ref_vstorage->num_levels_ != num_levels_ ||
+      !ref_vstorage->files_by_compaction_pri_reusable_[level]) {
+    return false;
+  }
+  // Comparing the file pointers is much cheaper than sorting them, and the
+  // FileMetaData (including its compensated size) is shared by the versions
+  if (ref_vstorage->files_[level] != files_[level]) {
+    return false;
+  }
+  assert(ref_vstorage->files_by_compaction_pri_[level].size() ==
+         files_[level].size());
+  // With kMinOverlappingRatio, the order also depends on the overlap with the
+  // next level
+  return ioptions.compaction_pri != kMinOverlappingRatio ||
+         ref_vstorage->files_[level + 1] == files_[level + 1];
+}
+
 void VersionStorageInfo::UpdateFilesByCompactionPri(
-    const ImmutableOptions& ioptions, const MutableCFOptions& options) {
+    const ImmutableOptions& ioptions, const MutableCFOptions& options,
+    const VersionStorageInfo* ref_vstorage) {
   if (compaction_style_ == kCompactionStyleNone ||
       compaction_style_ == kCompactionStyleFIFO ||
       compaction_style_ == kCompactionStyleUniversal) {
@@ -3881,6 +4082,31 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
     auto& files_by_compaction_pri = files_by_compaction_pri_[level];
     assert(files_by_compaction_pri.size() == 0);
 
+    switch (ioptions.compaction_pri) {
+      case kByCompensatedSize:
+      case kOldestLargestSeqFirst:
+      case kOldestSmallestSeqFirst:
+        files_by_compaction_pri_reusable_[level] = true;
+        break;
+      case kMinOverlappingRatio:
+        files_by_compaction_pri_reusable_[level] =
+            options.ttl == 0 || level == 0 ||
+            level >= num_non_empty_levels_ - 1;
+        break;
+      default:
+        // kRoundRobin depends on the compaction cursor, and kByReadAmpBenefit
+        // on the read stats of the files
+        files_by_compaction_pri_reusable_[level] = false;
+        break;
+    }
+
+    if (files_by_compaction_pri_reusable_[level] &&
+        CanReuseFilesByCompactionPri(ioptions, ref_vstorage, level)) {
+      files_by_compaction_pri = ref_vstorage->files_by_compaction_pri_[level];
+      next_file_to_compact_by_size_[level] = 0;
+      continue;
+    }
+
     // populate a temp vector for sorting based on size
     std::vector<Fsize> temp(files.size());
     for (size_t i = 0; i < files.size(); i++) {
@@ -3921,6 +4147,11 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
         SortFileByRoundRobin(*internal_comparator_, &compact_cursor_,
                              level0_non_overlapping_, level, &temp);
         break;
+      case kByReadAmpBenefit:
+        SortFileByReadAmpBenefit(*internal_comparator_, files_[level],
+                                 files_[level + 1], ioptions.clock, level,
+                                 num_non_empty_levels_, options.ttl, &temp);
+        break;
       default:
         assert(false);
     }
@@ -5162,7 +5393,8 @@ Status VersionSet::ProcessManifestWrites(
             true /* prefetch_index_and_filter_in_cache */,
             false /* is_initial_load */,
             mutable_cf_options_ptrs[i]->prefix_extractor,
-            MaxFileSizeForL0MetaPin(*mutable_cf_options_ptrs[i]));
+            MaxFileSizeForL0MetaPin(*mutable_cf_options_ptrs[i]),
+            db_options_->pin_table_readers_up_to_half_table_cache);
         if (!s.ok()) {
           if (db_options_->paranoid_checks) {
             break;
@@ -179,8 +179,13 @@ class VersionStorageInfo {
 
   void AddBlobFile(std::shared_ptr<BlobFileMetaData> blob_file_meta);
 
-  void PrepareForVersionAppend(const ImmutableOptions& immutable_options,
-                               const MutableCFOptions& mutable_cf_options);
+  // ref_vstorage, if not nullptr, is a finalized storage info (usually the
+  // current version's) whose per-level state may be reused for the levels
+  // whose files did not change.
+  void PrepareForVersionAppend(
+      const ImmutableOptions& immutable_options,
+      const MutableCFOptions& mutable_cf_options,
+      const VersionStorageInfo* ref_vstorage = nullptr);
 
   // REQUIRES: PrepareForVersionAppend has been called
   void SetFinalized();
@@ -235,7 +240,8 @@ class VersionStorageInfo {
   // REQUIRES: DB mutex held
   void ComputeFilesMarkedForForcedBlobGC(
       double blob_garbage_collection_age_cutoff,
-      double blob_garbage_collection_force_threshold);
+      double blob_garbage_collection_force_threshold,
+      uint32_t blob_garbage_collection_force_max_batches = 1);
 
   bool level0_non_overlapping() const { return level0_non_overlapping_; }
 
@@ -608,7 +614,11 @@ class VersionStorageInfo {
   void CalculateBaseBytes(const ImmutableOptions& ioptions,
                           const MutableCFOptions& options);
   void UpdateFilesByCompactionPri(const ImmutableOptions& immutable_options,
-                                  const MutableCFOptions& mutable_cf_options);
+                                  const MutableCFOptions& mutable_cf_options,
+                                  const VersionStorageInfo* ref_vstorage);
+  bool CanReuseFilesByCompactionPri(const ImmutableOptions& immutable_options,
+                                    const VersionStorageInfo* ref_vstorage,
+                                    int level) const;
 
   void GenerateFileIndexer() {
     file_indexer_.UpdateIndex(&arena_, num_non_empty_levels_, files_);
@@ -658,6 +668,11 @@ class VersionStorageInfo {
   // This vector stores the index of the file from files_.
   std::vector<std::vector<int>> files_by_compaction_pri_;
 
+  // Whether files_by_compaction_pri_[level] only depends on the files of the
+  // level (and of the next one), and not on the time or on the compaction
+  // cursor, so a later version with the same files may reuse it.
+  std::vector<bool> files_by_compaction_pri_reusable_;
+
   // If true, means that files in L0 have keys with non overlapping ranges
   bool level0_non_overlapping_;
 
@@ -1033,6 +1048,17 @@ class Version {
       TableCache::TypedHandle* table_handle, uint64_t& num_filter_read,
       uint64_t& num_index_read, uint64_t& num_sst_read);
 
+  // Looks up the files of the current level of fp that overlap the batch,
+  // starting at *f. The keys of all the files are filtered and their data
+  // blocks are prefetched before the files are looked up one after the other.
+  // Used for ReadOptions::async_io when coroutines aren't available.
+  Status MultiGetFromSSTsWithPrefetch(
+      const ReadOptions& read_options, FilePickerMultiGet* fp,
+      FdWithKeyRange** f,
+      std::unordered_map<uint64_t, BlobReadContexts>& blob_ctxs,
+      uint64_t& num_filter_read, uint64_t& num_index_read,
+      uint64_t& num_sst_read);
+
 #ifdef USE_COROUTINES
   // MultiGet using async IO to read data blocks from SST files in parallel
   // within and across levels
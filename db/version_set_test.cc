@@ -875,6 +875,116 @@ TEST_F(VersionStorageInfoTest, ForcedBlobGCMultipleBatches) {
   }
 }
 
+TEST_F(VersionStorageInfoTest, ForcedBlobGCSeveralBatches) {
+  // Add three L0 SSTs (1, 2, and 3) and five blob files (10 to 14). SST 1
+  // relies on blob file 10, SST 2 on blob file 12, and SST 3 on blob file 14,
+  // so the batches of blob files are {10, 11}, {12, 13}, and {14}. The oldest
+  // batch has little garbage, while the second one has a lot of it.
+
+  constexpr int level = 0;
+
+  constexpr uint64_t first_sst = 1;
+  constexpr uint64_t second_sst = 2;
+  constexpr uint64_t third_sst = 3;
+
+  Add(level, first_sst, "bar1", "foo1", 1000, 10);
+  Add(level, second_sst, "bar2", "foo2", 2000, 12);
+  Add(level, third_sst, "bar3", "foo3", 3000, 14);
+
+  AddBlob(10, 10, 100000, BlobFileMetaData::LinkedSsts{first_sst}, 1, 10000);
+  AddBlob(11, 10, 100000, BlobFileMetaData::LinkedSsts{}, 0, 0);
+  AddBlob(12, 10, 100000, BlobFileMetaData::LinkedSsts{second_sst}, 9, 90000);
+  AddBlob(13, 10, 100000, BlobFileMetaData::LinkedSsts{}, 9, 90000);
+  AddBlob(14, 10, 100000, BlobFileMetaData::LinkedSsts{third_sst}, 0, 0);
+
+  UpdateVersionStorageInfo();
+
+  assert(vstorage_.num_levels() > 0);
+  const auto& level_files = vstorage_.LevelFiles(level);
+
+  assert(level_files.size() == 3);
+  assert(level_files[0] && level_files[0]->fd.GetNumber() == first_sst);
+  assert(level_files[1] && level_files[1]->fd.GetNumber() == second_sst);
+  assert(level_files[2] && level_files[2]->fd.GetNumber() == third_sst);
+
+  auto sorted_ssts_to_be_compacted = [&]() {
+    auto ssts_to_be_compacted = vstorage_.FilesMarkedForForcedBlobGC();
+    std::sort(ssts_to_be_compacted.begin(), ssts_to_be_compacted.end(),
+              [](const std::pair<int, FileMetaData*>& lhs,
+                 const std::pair<int, FileMetaData*>& rhs) {
+                assert(lhs.second);
+                assert(rhs.second);
+                return lhs.second->fd.GetNumber() < rhs.second->fd.GetNumber();
+              });
+    return ssts_to_be_compacted;
+  };
+
+  // The garbage ratio of the oldest batch alone is below threshold
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.4;
+    constexpr uint32_t max_batches = 1;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold,
+                                                max_batches);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  }
+
+  // The garbage ratio of the two oldest batches together meets threshold
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.4;
+    constexpr uint32_t max_batches = 2;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold,
+                                                max_batches);
+
+    const auto ssts_to_be_compacted = sorted_ssts_to_be_compacted();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 2);
+    ASSERT_EQ(ssts_to_be_compacted[0], std::make_pair(level, level_files[0]));
+    ASSERT_EQ(ssts_to_be_compacted[1], std::make_pair(level, level_files[1]));
+  }
+
+  // No more batches than needed to meet the threshold are collected
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.4;
+    constexpr uint32_t max_batches = 3;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold,
+                                                max_batches);
+
+    ASSERT_EQ(sorted_ssts_to_be_compacted().size(), 2);
+  }
+
+  // The garbage ratio of the oldest batches is below threshold however many
+  // of them are considered
+
+  {
+    constexpr double age_cutoff = 1.0;
+    constexpr double force_threshold = 0.5;
+    constexpr uint32_t max_batches = 3;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold,
+                                                max_batches);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  }
+
+  // Part of the second batch (specifically, blob file 13) is ineligible for GC
+  // due to the age cutoff
+
+  {
+    constexpr double age_cutoff = 0.6;
+    constexpr double force_threshold = 0.4;
+    constexpr uint32_t max_batches = 2;
+    vstorage_.ComputeFilesMarkedForForcedBlobGC(age_cutoff, force_threshold,
+                                                max_batches);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForForcedBlobGC().empty());
+  }
+}
+
 class VersionStorageInfoTimestampTest : public VersionStorageInfoTestBase {
  public:
   VersionStorageInfoTimestampTest()
@@ -2151,6 +2261,58 @@ TEST_F(VersionStorageInfoTest, AddRangeDeletionCompensatedFileSize) {
   ASSERT_EQ(meta->compensated_file_size, 100U + 1000U);
 }
 
+TEST_F(VersionStorageInfoTest, ReuseFilesByCompactionPriOfUnchangedLevels) {
+  ioptions_.compaction_pri = kByCompensatedSize;
+
+  Add(1, 1U, "a", "b", 100U);
+  Add(1, 2U, "c", "d", 200U);
+  Add(2, 3U, "a", "b", 300U);
+  Add(2, 4U, "c", "d", 400U);
+  UpdateVersionStorageInfo();
+  ASSERT_EQ(vstorage_.FilesByCompactionPri(1), std::vector<int>({1, 0}));
+  ASSERT_EQ(vstorage_.FilesByCompactionPri(2), std::vector<int>({1, 0}));
+
+  // A new version in which only L2 changed
+  VersionStorageInfo new_vstorage(&icmp_, ucmp_, 6, kCompactionStyleLevel,
+                                  &vstorage_,
+                                  /*_force_consistency_checks=*/false);
+  for (auto* f : vstorage_.LevelFiles(1)) {
+    new_vstorage.AddFile(1, f);
+  }
+  for (auto* f : vstorage_.LevelFiles(2)) {
+    new_vstorage.AddFile(2, f);
+  }
+  FileMetaData* new_file = new FileMetaData(
+      5U, 0, 50U, GetInternalKey("e"), GetInternalKey("f"),
+      /* smallest_seq */ 0, /* largest_seq */ 0,
+      /* marked_for_compact */ false, Temperature::kUnknown,
+      kInvalidBlobFileNumber, kUnknownOldestAncesterTime,
+      kUnknownFileCreationTime, kUnknownEpochNumber, kUnknownFileChecksum,
+      kUnknownFileChecksumFuncName, kNullUniqueId64x2, 0);
+  new_vstorage.AddFile(2, new_file);
+
+  // Reverse the order of the sizes behind the back of the versions, so the
+  // levels whose order was reused can be told apart from the ones that were
+  // sorted again
+  vstorage_.LevelFiles(1)[0]->compensated_file_size = 1000U;
+  vstorage_.LevelFiles(2)[0]->compensated_file_size = 1000U;
+
+  new_vstorage.PrepareForVersionAppend(ioptions_, mutable_cf_options_,
+                                       &vstorage_);
+  new_vstorage.SetFinalized();
+  ASSERT_EQ(new_vstorage.FilesByCompactionPri(1), std::vector<int>({1, 0}));
+  ASSERT_EQ(new_vstorage.FilesByCompactionPri(2),
+            std::vector<int>({0, 1, 2}));
+
+  for (int i = 0; i < new_vstorage.num_levels(); ++i) {
+    for (auto* f : new_vstorage.LevelFiles(i)) {
+      if (--f->refs == 0) {
+        delete f;
+      }
+    }
+  }
+}
+
 class VersionSetWithTimestampTest : public VersionSetTest {
  public:
   static const std::string kNewCfName;
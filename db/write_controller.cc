@@ -77,7 +77,8 @@ bool WriteController::IsInRateMap(void* client_id) {
 // its write_rate is higher than the delayed_write_rate_ so we need to find a
 // new min from all clients via GetMapMinRate()
 void WriteController::HandleNewDelayReq(void* client_id,
-                                        uint64_t cf_write_rate) {
+                                        uint64_t cf_write_rate,
+                                        const void* writer_id) {
   assert(is_dynamic_delay());
   std::lock_guard<std::mutex> lock(map_mu_);
   bool was_min = IsMinRate(client_id);
@@ -93,6 +94,10 @@ void WriteController::HandleNewDelayReq(void* client_id,
     min_rate = GetMapMinRate();
   }
   set_delayed_write_rate(min_rate);
+  if (weighted_fair_delay_) {
+    id_to_writer_map_[client_id] = writer_id;
+    UpdateWritersRates();
+  }
 }
 
 // Checks if the client is in the id_to_write_rate_map_ , if it is:
@@ -111,10 +116,94 @@ void WriteController::HandleRemoveDelayReq(void* client_id) {
     if (was_min) {
       set_delayed_write_rate(GetMapMinRate());
     }
+    if (weighted_fair_delay_) {
+      id_to_writer_map_.erase(client_id);
+      UpdateWritersRates();
+    }
   }
   MaybeResetCounters();
 }
 
+void WriteController::RegisterWriter(const void* writer_id, uint32_t weight) {
+  assert(is_dynamic_delay());
+  std::lock_guard<std::mutex> lock(map_mu_);
+  {
+    std::lock_guard<std::mutex> metrics_lock(metrics_mu_);
+    writers_[writer_id].weight = std::max(weight, 1u);
+  }
+  if (weighted_fair_delay_) {
+    UpdateWritersRates();
+  }
+}
+
+void WriteController::DeregisterWriter(const void* writer_id) {
+  assert(is_dynamic_delay());
+  std::lock_guard<std::mutex> lock(map_mu_);
+  {
+    std::lock_guard<std::mutex> metrics_lock(metrics_mu_);
+    writers_.erase(writer_id);
+  }
+  if (weighted_fair_delay_) {
+    UpdateWritersRates();
+  }
+}
+
+WriteController::WriterDelayStats WriteController::GetWriterDelayStats(
+    const void* writer_id) {
+  std::lock_guard<std::mutex> lock(metrics_mu_);
+  auto writer_iter = writers_.find(writer_id);
+  if (writer_iter == writers_.end()) {
+    return WriterDelayStats();
+  }
+  return writer_iter->second.stats;
+}
+
+void WriteController::UpdateWritersRates() {
+  assert(weighted_fair_delay_);
+  // min rate of the requests of each writer's own clients, and of the
+  // requests that are shared by all the writers
+  std::unordered_map<const void*, uint64_t> writers_min_rates;
+  uint64_t shared_min_rate = 0;
+  for (const auto& [client_id, rate] : id_to_write_rate_map_) {
+    auto writer_iter = id_to_writer_map_.find(client_id);
+    const void* writer_id =
+        writer_iter == id_to_writer_map_.end() ? nullptr : writer_iter->second;
+    uint64_t& min_rate =
+        writer_id == nullptr ? shared_min_rate : writers_min_rates[writer_id];
+    if (min_rate == 0 || rate < min_rate) {
+      min_rate = rate;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(metrics_mu_);
+  uint64_t total_weight = 0;
+  for (const auto& [writer_id, writer] : writers_) {
+    total_weight += writer.weight;
+  }
+  for (auto& [writer_id, writer] : writers_) {
+    uint64_t rate = 0;
+    auto min_rate_iter = writers_min_rates.find(writer_id);
+    if (min_rate_iter != writers_min_rates.end()) {
+      rate = min_rate_iter->second;
+    }
+    if (shared_min_rate > 0) {
+      uint64_t share = std::max(
+          static_cast<uint64_t>(1.0 * shared_min_rate * writer.weight /
+                                total_weight),
+          kMinWriteRate);
+      rate = rate == 0 ? share : std::min(rate, share);
+    }
+    if (rate > 0) {
+      rate = std::min<uint64_t>(rate, max_delayed_write_rate_);
+    } else {
+      // the writer isn't delayed. start a new delay from scratch
+      writer.credit_in_bytes = 0;
+      writer.next_refill_time = 0;
+    }
+    writer.stats.delayed_write_rate = rate;
+  }
+}
+
 bool WriteController::RemoveDelayReq(void* client_id) {
   bool was_min = IsMinRate(client_id);
   [[maybe_unused]] bool erased = id_to_write_rate_map_.erase(client_id);
@@ -129,6 +218,10 @@ void WriteController::MaybeResetCounters() {
     // reset counters.
     next_refill_time_ = 0;
     credit_in_bytes_ = 0;
+    for (auto& [writer_id, writer] : writers_) {
+      writer.next_refill_time = 0;
+      writer.credit_in_bytes = 0;
+    }
   }
 }
 
@@ -158,7 +251,8 @@ bool WriteController::IsStopped() const {
 // If it turns out to be a performance issue, we can redesign the thread
 // synchronization model here.
 // The function trust caller will sleep micros returned.
-uint64_t WriteController::GetDelay(SystemClock* clock, uint64_t num_bytes) {
+uint64_t WriteController::GetDelay(SystemClock* clock, uint64_t num_bytes,
+                                   const void* writer_id) {
   if (total_stopped_.load(std::memory_order_relaxed) > 0) {
     return 0;
   }
@@ -168,47 +262,82 @@ uint64_t WriteController::GetDelay(SystemClock* clock, uint64_t num_bytes) {
 
   std::lock_guard<std::mutex> lock(metrics_mu_);
 
+  if (weighted_fair_delay_ && writer_id != nullptr) {
+    auto writer_iter = writers_.find(writer_id);
+    if (writer_iter == writers_.end()) {
+      return 0;
+    }
+    WriterState& writer = writer_iter->second;
+    if (writer.stats.delayed_write_rate == 0) {
+      return 0;
+    }
+    if (writer.credit_in_bytes >= num_bytes) {
+      writer.credit_in_bytes -= num_bytes;
+      return 0;
+    }
+    uint64_t delay = TakeCredit(
+        NowMicrosMonotonic(clock), num_bytes, writer.stats.delayed_write_rate,
+        &writer.credit_in_bytes, &writer.next_refill_time);
+    if (delay > 0) {
+      ++writer.stats.num_delayed_writes;
+      writer.stats.total_delay_micros += delay;
+    }
+    return delay;
+  }
+
   if (credit_in_bytes_ >= num_bytes) {
     credit_in_bytes_ -= num_bytes;
     return 0;
   }
   // The frequency to get time inside DB mutex is less than one per refill
   // interval.
-  auto time_now = NowMicrosMonotonic(clock);
+  uint64_t credit_in_bytes = credit_in_bytes_;
+  uint64_t next_refill_time = next_refill_time_;
+  uint64_t delay =
+      TakeCredit(NowMicrosMonotonic(clock), num_bytes, delayed_write_rate_,
+                 &credit_in_bytes, &next_refill_time);
+  credit_in_bytes_ = credit_in_bytes;
+  next_refill_time_ = next_refill_time;
+  return delay;
+}
 
+uint64_t WriteController::TakeCredit(uint64_t time_now, uint64_t num_bytes,
+                                     uint64_t write_rate,
+                                     uint64_t* credit_in_bytes,
+                                     uint64_t* next_refill_time) {
   const uint64_t kMicrosPerSecond = 1000000;
   // Refill every 1 ms
   const uint64_t kMicrosPerRefill = 1000;
 
-  if (next_refill_time_ == 0) {
+  if (*next_refill_time == 0) {
     // Start with an initial allotment of bytes for one interval
-    next_refill_time_ = time_now;
+    *next_refill_time = time_now;
   }
-  if (next_refill_time_ <= time_now) {
+  if (*next_refill_time <= time_now) {
     // Refill based on time interval plus any extra elapsed
-    uint64_t elapsed = time_now - next_refill_time_ + kMicrosPerRefill;
-    credit_in_bytes_ += static_cast<uint64_t>(
-        1.0 * elapsed / kMicrosPerSecond * delayed_write_rate_ + 0.999999);
-    next_refill_time_ = time_now + kMicrosPerRefill;
+    uint64_t elapsed = time_now - *next_refill_time + kMicrosPerRefill;
+    *credit_in_bytes += static_cast<uint64_t>(
+        1.0 * elapsed / kMicrosPerSecond * write_rate + 0.999999);
+    *next_refill_time = time_now + kMicrosPerRefill;
 
-    if (credit_in_bytes_ >= num_bytes) {
+    if (*credit_in_bytes >= num_bytes) {
       // Avoid delay if possible, to reduce DB mutex release & re-aquire.
-      credit_in_bytes_ -= num_bytes;
+      *credit_in_bytes -= num_bytes;
       return 0;
     }
   }
 
   // We need to delay to avoid exceeding write rate.
-  assert(num_bytes > credit_in_bytes_);
-  uint64_t bytes_over_budget = num_bytes - credit_in_bytes_;
+  assert(num_bytes > *credit_in_bytes);
+  uint64_t bytes_over_budget = num_bytes - *credit_in_bytes;
   uint64_t needed_delay = static_cast<uint64_t>(
-      1.0 * bytes_over_budget / delayed_write_rate_ * kMicrosPerSecond);
+      1.0 * bytes_over_budget / write_rate * kMicrosPerSecond);
 
-  credit_in_bytes_ = 0;
-  next_refill_time_ += needed_delay;
+  *credit_in_bytes = 0;
+  *next_refill_time += needed_delay;
 
   // Minimum delay of refill interval, to reduce DB mutex contention.
-  return std::max(next_refill_time_ - time_now, kMicrosPerRefill);
+  return std::max(*next_refill_time - time_now, kMicrosPerRefill);
 }
 
 uint64_t WriteController::NowMicrosMonotonic(SystemClock* clock) {
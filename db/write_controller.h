@@ -11,6 +11,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "rocksdb/rate_limiter.h"
 
@@ -29,12 +30,20 @@ class ErrorHandler;
 // many dbs which requires using metrics_mu_ and map_mu_.
 // In a shared state (global delay mechanism), the WriteController can also
 // receive delay requirements from the WriteBufferManager.
+// When weighted_fair_delay is also true, every db (writer) that shares the
+// WriteController gets its own delayed write rate and credit instead of all of
+// them sharing the minimal rate. The delay requests of a column family only
+// apply to the writes of its own db, while the requests that don't belong to
+// a db (e.g. of a WriteBufferManager) are split between the registered dbs in
+// proportion to their weights.
 class WriteController {
  public:
   explicit WriteController(bool dynamic_delay,
                            uint64_t _delayed_write_rate = 1024u * 1024u * 16u,
-                           int64_t low_pri_rate_bytes_per_sec = 1024 * 1024)
+                           int64_t low_pri_rate_bytes_per_sec = 1024 * 1024,
+                           bool weighted_fair_delay = false)
       : dynamic_delay_(dynamic_delay),
+        weighted_fair_delay_(dynamic_delay && weighted_fair_delay),
         total_stopped_(0),
         total_delayed_(0),
         total_compaction_pressure_(0),
@@ -49,6 +58,8 @@ class WriteController {
   static constexpr uint64_t kMinWriteRate =
       16 * 1024u;  // Minimum write rate 16KB/s.
 
+  static constexpr uint32_t kDefaultWriterWeight = 1;
+
   // When an actor (column family) requests a stop token, all writes will be
   // stopped until the stop token is released (deleted)
   std::unique_ptr<WriteControllerToken> GetStopToken();
@@ -70,8 +81,10 @@ class WriteController {
   }
   // return how many microseconds the caller needs to sleep after the call
   // num_bytes: how many number of bytes to put into the DB.
+  // writer_id: the db that writes. only used with weighted_fair_delay.
   // Prerequisite: DB mutex held.
-  uint64_t GetDelay(SystemClock* clock, uint64_t num_bytes);
+  uint64_t GetDelay(SystemClock* clock, uint64_t num_bytes,
+                    const void* writer_id = nullptr);
   void set_delayed_write_rate(uint64_t write_rate) {
     std::lock_guard<std::mutex> lock(metrics_mu_);
     // avoid divide 0
@@ -102,6 +115,8 @@ class WriteController {
 
   bool is_dynamic_delay() const { return dynamic_delay_; }
 
+  bool is_weighted_fair_delay() const { return weighted_fair_delay_; }
+
   int TEST_total_delayed_count() const { return total_delayed_.load(); }
 
   /////// methods and members used when dynamic_delay_ == true. ///////
@@ -109,7 +124,10 @@ class WriteController {
   // and the Id (void*) is simply the pointer to their obj
   using ClientIdToRateMap = std::unordered_map<void*, uint64_t>;
 
-  void HandleNewDelayReq(void* client_id, uint64_t cf_write_rate);
+  // writer_id is the db the client belongs to, or nullptr if the delay
+  // request applies to all the dbs.
+  void HandleNewDelayReq(void* client_id, uint64_t cf_write_rate,
+                         const void* writer_id = nullptr);
 
   // Removes a client's delay and updates the Write Controller's effective
   // delayed write rate if applicable
@@ -117,6 +135,23 @@ class WriteController {
 
   uint64_t TEST_GetMapMinRate();
 
+  // Writers (dbs) register with their weight when opened and deregister when
+  // closed. Only the registered writers get a share of the delayed write rate
+  // when weighted_fair_delay is used.
+  void RegisterWriter(const void* writer_id,
+                      uint32_t weight = kDefaultWriterWeight);
+  void DeregisterWriter(const void* writer_id);
+
+  struct WriterDelayStats {
+    // the current delayed write rate of the writer. 0 if it isn't delayed
+    uint64_t delayed_write_rate = 0;
+    // number of writes that were delayed and their total delay
+    uint64_t num_delayed_writes = 0;
+    uint64_t total_delay_micros = 0;
+  };
+  // Only maintained with weighted_fair_delay
+  WriterDelayStats GetWriterDelayStats(const void* writer_id);
+
   void WaitOnCV(std::function<bool()> continue_wait);
   void NotifyCV();
 
@@ -132,11 +167,38 @@ class WriteController {
   // REQUIRES: write_controller map_mu_ mutex held.
   uint64_t GetMapMinRate();
 
+  // Recalculates the delayed write rate of every writer from the delay
+  // requests of its own clients and its share of the shared requests.
+  // REQUIRES: write_controller map_mu_ mutex held.
+  void UpdateWritersRates();
+
+  // Takes num_bytes from the credit that is refilled at write_rate and
+  // returns how many microseconds the caller needs to sleep.
+  // REQUIRES: metrics_mu_ held.
+  static uint64_t TakeCredit(uint64_t time_now, uint64_t num_bytes,
+                             uint64_t write_rate, uint64_t* credit_in_bytes,
+                             uint64_t* next_refill_time);
+
   // Whether Speedb's dynamic delay is used
   bool dynamic_delay_ = true;
+  // Whether the delayed write rate is split between the writers
+  bool weighted_fair_delay_ = false;
 
   std::mutex map_mu_;
   ClientIdToRateMap id_to_write_rate_map_;
+  // The writer each client belongs to (nullptr for shared clients). Used only
+  // with weighted_fair_delay.
+  std::unordered_map<void*, const void*> id_to_writer_map_;
+
+  struct WriterState {
+    uint32_t weight = kDefaultWriterWeight;
+    uint64_t credit_in_bytes = 0;
+    uint64_t next_refill_time = 0;
+    WriterDelayStats stats;
+  };
+  // Protected by both map_mu_ and metrics_mu_ for adding and removing writers
+  // and by metrics_mu_ for changing their state.
+  std::unordered_map<const void*, WriterState> writers_;
 
   // The mutex used by stop_cv_
   std::mutex stop_mu_;
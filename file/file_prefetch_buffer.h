@@ -78,6 +78,9 @@ class FilePrefetchBuffer {
   //   it. Used for adaptable readahead of the file footer/metadata.
   // implicit_auto_readahead : Readahead is enabled implicitly by rocksdb after
   //   doing sequential scans for two times.
+  // max_readahead_gap : With implicit_auto_readahead, a read that starts at
+  //   most this many bytes after the end of the previous read is still
+  //   sequential, so skipping a few blocks doesn't reset the readahead.
   //
   // Automatic readhead is enabled for a file if readahead_size
   // and max_readahead_size are passed in.
@@ -89,7 +92,8 @@ class FilePrefetchBuffer {
       bool implicit_auto_readahead = false, uint64_t num_file_reads = 0,
       uint64_t num_file_reads_for_auto_readahead = 0, FileSystem* fs = nullptr,
       SystemClock* clock = nullptr, Statistics* stats = nullptr,
-      FilePrefetchBufferUsage usage = FilePrefetchBufferUsage::kUnknown)
+      FilePrefetchBufferUsage usage = FilePrefetchBufferUsage::kUnknown,
+      size_t max_readahead_gap = 0)
       : curr_(0),
         readahead_size_(readahead_size),
         initial_auto_readahead_size_(readahead_size),
@@ -106,7 +110,8 @@ class FilePrefetchBuffer {
         fs_(fs),
         clock_(clock),
         stats_(stats),
-        usage_(usage) {
+        usage_(usage),
+        max_readahead_gap_(max_readahead_gap) {
     assert((num_file_reads_ >= num_file_reads_for_auto_readahead_ + 1) ||
            (num_file_reads_ == 0));
     // If ReadOptions.async_io is enabled, data is asynchronously filled in
@@ -315,7 +320,9 @@ class FilePrefetchBuffer {
   void CopyDataToBuffer(uint32_t src, uint64_t& offset, size_t& length);
 
   bool IsBlockSequential(const size_t& offset) {
-    return (prev_len_ == 0 || (prev_offset_ + prev_len_ == offset));
+    return (prev_len_ == 0 ||
+            (offset >= prev_offset_ + prev_len_ &&
+             offset - (prev_offset_ + prev_len_) <= max_readahead_gap_));
   }
 
   // Called in case of implicit auto prefetching.
@@ -463,5 +470,8 @@ class FilePrefetchBuffer {
   Statistics* stats_;
 
   FilePrefetchBufferUsage usage_;
+
+  // Forward gap between two reads that are still considered sequential
+  size_t max_readahead_gap_;
 };
 }  // namespace ROCKSDB_NAMESPACE
@@ -2225,6 +2225,50 @@ TEST_F(FilePrefetchBufferTest, SeekWithBlockCacheHit) {
                                         &result, &s, Env::IOPriority::IO_LOW));
 }
 
+TEST_F(FilePrefetchBufferTest, MaxReadaheadGap) {
+  std::string fname = "max-readahead-gap";
+  Random rand(0);
+  std::string content = rand.RandomString(65536);
+  Write(fname, content);
+
+  FileOptions opts;
+  std::unique_ptr<RandomAccessFileReader> r;
+  Read(fname, opts, &r);
+
+  for (size_t max_gap : {size_t{0}, size_t{8192}}) {
+    FilePrefetchBuffer fpb(
+        /*readahead_size=*/4096, /*max_readahead_size=*/65536, /*enable=*/true,
+        /*track_min_offset=*/false, /*implicit_auto_readahead=*/true,
+        /*num_file_reads=*/0, /*num_file_reads_for_auto_readahead=*/0, fs(),
+        /*clock=*/nullptr, /*stats=*/nullptr, FilePrefetchBufferUsage::kUnknown,
+        max_gap);
+    Slice result;
+    Status s;
+    // Prefetches 1000 + 4096 bytes, rounded up to the alignment (8192)
+    ASSERT_TRUE(fpb.TryReadFromCache(IOOptions(), r.get(), /*offset=*/0,
+                                     /*n=*/1000, &result, &s, Env::IO_TOTAL));
+    ASSERT_OK(s);
+    ASSERT_EQ(result, Slice(content.data(), 1000));
+
+    // Skip 8000 bytes, past the prefetched data
+    bool found = fpb.TryReadFromCache(IOOptions(), r.get(), /*offset=*/9000,
+                                      /*n=*/1000, &result, &s, Env::IO_TOTAL);
+    ASSERT_OK(s);
+    ReadaheadFileInfo::ReadaheadInfo readahead_info;
+    fpb.GetReadaheadState(&readahead_info);
+    if (max_gap == 0) {
+      // Not sequential, the readahead starts over
+      ASSERT_FALSE(found);
+      ASSERT_EQ(readahead_info.readahead_size, 4096);
+    } else {
+      // Sequential with a small gap, the readahead keeps growing
+      ASSERT_TRUE(found);
+      ASSERT_EQ(result, Slice(content.data() + 9000, 1000));
+      ASSERT_EQ(readahead_info.readahead_size, 16384);
+    }
+  }
+}
+
 TEST_F(FilePrefetchBufferTest, NoSyncWithAsyncIO) {
   std::string fname = "seek-with-block-cache-hit";
   Random rand(0);
@@ -355,6 +355,20 @@ class Cache {
   // Returns the memory size for the entries in use by the system
   virtual size_t GetPinnedUsage() const = 0;
 
+  // Returns the capacity of the part of the cache that an entry of `key`
+  // would be inserted into, i.e. its shard in a sharded cache. Defaults to
+  // the capacity of the whole cache.
+  virtual size_t GetShardCapacity(const Slice& /*key*/) const {
+    return GetCapacity();
+  }
+
+  // Returns the memory size for the entries in use by the system in the
+  // part of the cache that an entry of `key` would be inserted into.
+  // Defaults to the pinned usage of the whole cache.
+  virtual size_t GetShardPinnedUsage(const Slice& /*key*/) const {
+    return GetPinnedUsage();
+  }
+
   // Returns the charge for the specific entry in the cache.
   virtual size_t GetCharge(Handle* handle) const = 0;
 
@@ -584,6 +598,14 @@ class CacheWrapper : public Cache {
 
   size_t GetPinnedUsage() const override { return target_->GetPinnedUsage(); }
 
+  size_t GetShardCapacity(const Slice& key) const override {
+    return target_->GetShardCapacity(key);
+  }
+
+  size_t GetShardPinnedUsage(const Slice& key) const override {
+    return target_->GetShardPinnedUsage(key);
+  }
+
   size_t GetCharge(Handle* handle) const override {
     return target_->GetCharge(handle);
   }
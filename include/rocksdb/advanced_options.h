@@ -57,6 +57,14 @@ enum CompactionPri : char {
   // level. The file picking process will cycle through all the files in a
   // round-robin manner.
   kRoundRobin = 0x4,
+  // First compact files with the best ratio between the read amplification
+  // they remove and the bytes the compaction rewrites. The bytes rewritten
+  // are estimated as in kMinOverlappingRatio, with the file size compensated
+  // by its deletions, so that files dense in tombstones are cheaper. The read
+  // benefit grows with the number of sampled reads that hit the file, so hot
+  // key ranges are compacted first while cold ones are left alone longer.
+  // Without reads, this orders files like kMinOverlappingRatio.
+  kByReadAmpBenefit = 0x5,
 };
 
 struct CompactionOptionsFIFO {
@@ -134,6 +142,12 @@ struct CompressionOptions {
   // Parallel compression is enabled only if threads > 1.
   // THE FEATURE IS STILL EXPERIMENTAL
   //
+  // The blocks are compressed by a pool of workers that is shared by all the
+  // flushes and compactions of the process, and parallel_threads bounds the
+  // number of blocks of a single SST file being compressed at the same time.
+  // The pool has as many workers as the largest parallel_threads used so far
+  // in the process, but no more than the number of hardware threads.
+  //
   // This option is valid only when BlockBasedTable is used.
   //
   // When parallel compression is enabled, SST size file sizes might be
@@ -497,6 +511,16 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t arena_block_size = 0;
 
+  // If true, the arena blocks of a memtable start at 4KB and double in size
+  // up to arena_block_size, and so do the per-core blocks used by concurrent
+  // writers. A memtable that holds little data (e.g. one of many small
+  // column families) then uses memory in proportion to its data instead of a
+  // full arena_block_size (and a per-core block for every core that wrote to
+  // it), at the cost of a few more, smaller, allocations while it fills up.
+  //
+  // Default: false
+  bool memtable_grow_arena_blocks = false;
+
   // Different levels can have different compression policies. There
   // are cases where most lower levels would like to use quick compression
   // algorithms while the higher levels (which have more data) use
@@ -1028,6 +1052,21 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   double blob_garbage_collection_force_threshold = 1.0;
 
+  // The maximum number of batches of the oldest blob files whose garbage
+  // ratio is considered together against
+  // blob_garbage_collection_force_threshold above. A batch is a set of blob
+  // files that are kept alive by the same SSTs. With 1, forced GC only
+  // collects the oldest batch, and only once it has enough garbage on its
+  // own. With more batches, it also collects the oldest batches together when
+  // their combined garbage ratio exceeds the threshold (e.g. old blob files
+  // with little garbage followed by younger ones with a lot of it), as long as
+  // they are all eligible based on blob_garbage_collection_age_cutoff.
+  //
+  // Default: 1
+  //
+  // Dynamically changeable through the SetOptions() API
+  uint32_t blob_garbage_collection_force_max_batches = 1;
+
   // Compaction readahead for blob files.
   //
   // Default: 0
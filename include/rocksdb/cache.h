@@ -185,6 +185,15 @@ struct LRUCacheOptions : public ShardedCacheOptions {
   // -DROCKSDB_DEFAULT_TO_ADAPTIVE_MUTEX, false otherwise.
   bool use_adaptive_mutex = kDefaultToAdaptiveMutex;
 
+  // If true, and RocksDB is built with NUMA support (-DNUMA) on a NUMA
+  // system, the cache keeps a group of shards per NUMA node, allocated on
+  // that node. An entry is inserted into the shards of the node of the
+  // inserting thread, and lookups probe the local node's shards before the
+  // remote ones, so blocks read mostly by threads of one node are served
+  // from local memory. The capacity is split evenly over all the nodes, and
+  // num_shard_bits applies to each node's group.
+  bool numa_aware = false;
+
   LRUCacheOptions() {}
   LRUCacheOptions(size_t _capacity, int _num_shard_bits,
                   bool _strict_capacity_limit, double _high_pri_pool_ratio,
@@ -243,6 +252,20 @@ struct CompressedSecondaryCacheOptions : LRUCacheOptions {
   // (Filter blocks are essentially non-compressible but others usually are.)
   CacheEntryRoleSet do_not_compress_roles = {CacheEntryRole::kFilterBlock};
 
+  // If > 0, a block is kept compressed only if its compressed size is at most
+  // this fraction of its size (e.g. 0.8 keeps compressed the blocks that
+  // compress by at least 20%). The other blocks are stored uncompressed, so
+  // their promotions don't pay a decompression for little saved memory.
+  // 0 (default) keeps all the blocks compressed.
+  double max_compressed_size_ratio = 0.0;
+
+  // If > 0, a block that was promoted from this cache at least this many times
+  // recently (as estimated by a small frequency sketch) is stored
+  // uncompressed when it is demoted again, so that hot blocks don't pay a
+  // decompression on each of their promotions.
+  // 0 (default) keeps all the blocks compressed.
+  uint32_t uncompressed_hot_block_promotions = 0;
+
   CompressedSecondaryCacheOptions() {}
   CompressedSecondaryCacheOptions(
       size_t _capacity, int _num_shard_bits, bool _strict_capacity_limit,
@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "rocksdb/cleanable.h"
 #include "rocksdb/slice.h"
@@ -64,6 +66,18 @@ class Iterator : public Cleanable {
   // Target does not contain timestamp.
   virtual void SeekForPrev(const Slice& target) = 0;
 
+  // Seeks to each of `targets` in turn, which must be sorted in ascending
+  // order, and calls `callback(i)` once the iterator is positioned as if by
+  // Seek(targets[i]). The callback may read and move the iterator (e.g. call
+  // Next() a few times), and returns false to stop the batch.
+  //
+  // Equivalent to calling Seek() for each target, but an implementation may
+  // reach a target that is just ahead of the current position by stepping
+  // forward instead of seeking all the sources again. DB iterators do so in
+  // total order mode, without timestamps.
+  virtual void SeekMany(const std::vector<Slice>& targets,
+                        const std::function<bool(size_t)>& callback);
+
   // Moves to the next entry in the source.  After this call, Valid() is
   // true iff the iterator was not positioned at the last entry in the source.
   // REQUIRES: Valid()
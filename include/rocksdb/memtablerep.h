@@ -383,6 +383,11 @@ class MemTableRepFactory : public Customizable {
 
           switch_memtable_thread_cv_.wait(lck);
         }
+        // The factory may be destroyed before the first memtable was
+        // created, and then PreCreateMemTableRep() keeps returning nullptr
+        if (terminate_switch_memtable_.load()) {
+          return;
+        }
       }
 
       // Construct new memtable only for the heavy object initilized proposed
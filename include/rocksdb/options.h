@@ -605,6 +605,27 @@ struct DBOptions {
   // Default: 16
   int max_file_opening_threads = 16;
 
+  // The table readers of the files that are opened when a version is built
+  // (on DB::Open() and after flushes, compactions and ingestions) are pinned
+  // in the file metadata, so that point lookups and iterators on these files
+  // skip the table cache lookup and its reference counting. If max_open_files
+  // is -1, all of them are pinned. Otherwise, only up to a quarter of
+  // max_open_files are pinned, and at most 16 on DB::Open().
+  //
+  // If this option is true and max_open_files is not -1, the table readers
+  // are pinned until half of the table cache is used, on DB::Open() too
+  // (which then opens up to half of max_open_files files, using
+  // max_file_opening_threads threads). Pinned table readers are never evicted
+  // from the table cache, so the files that are not pinned share the other
+  // half of it, in LRU order as usual. The table cache is split into
+  // 2^table_cache_numshardbits shards, and the half is kept free in each
+  // shard: a file is not pinned if half of its shard is pinned already. So
+  // nothing is pinned unless the table cache has at least 2 entries per shard
+  // (max_open_files - 10 >= 2 * 2^table_cache_numshardbits).
+  //
+  // Default: false
+  bool pin_table_readers_up_to_half_table_cache = false;
+
   // Once write-ahead logs exceed this size, we will start forcing the flush of
   // column families whose memtables are backed by the oldest live WAL file
   // (i.e. the ones that are causing all the space amplification). If set to 0
@@ -725,6 +746,18 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint32_t max_subcompactions = 1;
 
+  // When a compaction is split into subcompactions, split its input into up
+  // to this many key ranges per subcompaction thread. The threads take the
+  // next unprocessed range whenever they finish one, so a range that takes
+  // much longer than the others (e.g. because of skewed data) does not keep
+  // the rest of the threads idle. A range is never smaller than the target
+  // file size of the output level, so small compactions are not split
+  // further.
+  // Default: 1 (a single range per subcompaction thread)
+  //
+  // Dynamically changeable through SetDBOptions() API.
+  uint32_t subcompaction_ranges_per_thread = 1;
+
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -1067,6 +1100,16 @@ struct DBOptions {
   // Default: true
   bool use_dynamic_delay = true;
 
+  // The share of this DB in the delayed write rate of a WriteController that
+  // is shared between several DBs and was created with weighted_fair_delay.
+  // Delay requests that aren't owned by a specific DB (e.g. those of the
+  // WriteBufferManager) are split between the DBs in proportion to their
+  // weights, while the delay requests of a DB's own column families only
+  // slow down that DB. Ignored by other WriteControllers.
+  //
+  // Default: 1
+  uint32_t write_controller_weight = 1;
+
   // By default, a single write thread queue is maintained. The thread gets
   // to the head of the queue becomes write batch group leader and responsible
   // for writing to WAL and memtable for the batch group.
@@ -1191,6 +1234,20 @@ struct DBOptions {
   // Default: nullptr (disabled)
   std::shared_ptr<Cache> row_cache = nullptr;
 
+  // If true, a row read from an SST file is inserted into row_cache only once
+  // it was read at least twice recently, as estimated by a small frequency
+  // sketch (aged as reads go on). Keys that are read only once, e.g. by
+  // scan-like point lookups, then don't evict the hot rows from the row
+  // cache. Row cache hits are not affected.
+  // Has no effect if row_cache is nullptr.
+  //
+  // The sketch takes about 1 byte per 128 bytes of row_cache capacity,
+  // between 2KB and 128KB. It is not charged to row_cache, and there is one
+  // per row cache, shared by all the column families and DBs using it.
+  //
+  // Default: false
+  bool row_cache_frequency_admission = false;
+
   // If true during flush we skip any entry that has a followed delete
   // entry (#411)
   bool use_clean_delete_during_flush = false;
@@ -1222,6 +1279,14 @@ struct DBOptions {
   // DEFAULT: false
   bool avoid_flush_during_recovery = false;
 
+  // If true, DB::Open() reads the records of each WAL on a background thread,
+  // ahead of their replay into the memtables, so that reading the WAL files
+  // and verifying their checksums overlaps with the memtable inserts instead
+  // of adding up with them. The replay itself is unchanged.
+  //
+  // DEFAULT: false
+  bool enable_pipelined_wal_recovery = false;
+
   // By default RocksDB will flush all memtables on DB close if there are
   // unpersisted data (i.e. with WAL disabled) The flush can be skip to speedup
   // DB close. Unpersisted data WILL BE LOST.
@@ -1553,6 +1618,17 @@ struct ReadOptions {
   // Default: 0
   size_t readahead_size;
 
+  // If non-zero, iterators read ahead this many bytes when they fetch a blob
+  // value from a blob file (when using the integrated BlobDB), keeping a
+  // readahead buffer per blob file. Since blob files are written in key
+  // order, the blobs of consecutive keys are mostly next to each other, and
+  // a range scan over blob values then issues a large read every few keys
+  // instead of a small read per key. Blobs found in the blob cache are not
+  // read from the files. Only forward iteration reads ahead; Prev() and
+  // SeekForPrev() read each blob on its own.
+  // Default: 0
+  size_t blob_readahead_size;
+
   // A threshold for the number of keys that can be skipped before failing an
   // iterator seek as incomplete. The default value of 0 should be used to
   // never fail a request as incomplete, even on skipping too many keys.
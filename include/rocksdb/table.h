@@ -655,6 +655,24 @@ struct BlockBasedTableOptions {
   //
   // Default: 2
   uint64_t num_file_reads_for_auto_readahead = 2;
+
+  // Auto-readahead considers a read sequential if it starts where the previous
+  // read of the file ended, and resets the readahead size to
+  // initial_auto_readahead_size on any other read. If this is > 0, a read
+  // that starts at most max_auto_readahead_gap_size bytes after the end of
+  // the previous read is sequential too, so scans that skip a few blocks
+  // (e.g. short forward seeks, or blocks that were found in the block cache)
+  // keep growing their readahead instead of starting over with small reads.
+  //
+  // This parameter can be changed dynamically by
+  // DB::SetOptions({{"block_based_table_factory",
+  //                  "{max_auto_readahead_gap_size=0;}"}}));
+  //
+  // Changing the value dynamically will only affect files opened after the
+  // change.
+  //
+  // Default: 0
+  size_t max_auto_readahead_gap_size = 0;
 };
 
 // Table Properties that are specific to block-based table properties.
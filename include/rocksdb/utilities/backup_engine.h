@@ -122,6 +122,14 @@ struct BackupEngineOptions {
   // Default: 1
   int max_background_operations;
 
+  // If true, each file copy reads its next chunk from the source file on a
+  // helper thread while the current chunk is checksummed and written to the
+  // destination, so reads and writes of large files overlap instead of
+  // alternating. Applies to both CreateNewBackup() and RestoreDBFromBackup(),
+  // on top of the parallelism across files of max_background_operations.
+  // Default: false
+  bool pipelined_file_copy = false;
+
   // During backup user can get callback every time next
   // callback_trigger_interval_size bytes being copied.
   // Default: 4194304
@@ -15,6 +15,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
@@ -31,6 +32,7 @@ struct Options;
 class CacheReservationManager;
 class InstrumentedMutex;
 class InstrumentedCondVar;
+class SystemClock;
 class WriteController;
 
 // Interface to block and signal DB instances, intended for RocksDB
@@ -64,12 +66,21 @@ class WriteBufferManager final {
 
     FlushInitiationOptions() {}
 
-    FlushInitiationOptions(size_t _max_num_parallel_flushes)
-        : max_num_parallel_flushes(_max_num_parallel_flushes) {}
+    FlushInitiationOptions(size_t _max_num_parallel_flushes,
+                           bool _predictive_flushes = false)
+        : max_num_parallel_flushes(_max_num_parallel_flushes),
+          predictive_flushes(_predictive_flushes) {}
 
     FlushInitiationOptions Sanitize() const;
 
     size_t max_num_parallel_flushes = kDfltMaxNumParallelFlushes;
+
+    // When set, the WBM tracks the rate at which memory is reserved and the
+    // duration of flushes (both as EWMAs), and initiates flushes earlier by
+    // the number of bytes expected to be ingested while a flush runs (capped
+    // at half a flush step). This lets flushes complete before bursts push
+    // the memory usage into the delay range.
+    bool predictive_flushes = false;
   };
 
   static constexpr bool kDfltAllowStall = false;
@@ -273,6 +284,8 @@ class WriteBufferManager final {
     return num_flushes_to_initiate_;
   }
   size_t TEST_GetNumRunningFlushes() const { return num_running_flushes_; }
+  size_t TEST_GetFlushLookaheadBytes() const { return flush_lookahead_bytes_; }
+  void TEST_SetClock(SystemClock* clock) { clock_ = clock; }
   size_t TEST_GetNextCandidateInitiatorIdx() const {
     return next_candidate_initiator_idx_;
   }
@@ -387,6 +400,16 @@ class WriteBufferManager final {
   void WakeupFlushInitiationThreadNoLockHeld();
   void WakeupFlushInitiationThreadLockHeld();
 
+  // Predictive flushes (see FlushInitiationOptions::predictive_flushes)
+  bool IsPredictingFlushes() const {
+    return initiate_flushes_ && flush_initiation_options_.predictive_flushes;
+  }
+  void UpdateIngestRate(size_t mem);
+  void RecordFlushStart();
+  void RecordFlushEnd();
+  // Should be called under the forecast_mu_ lock
+  void RecalcFlushLookahead();
+
   // Heuristic to decide if another flush is needed taking into account
   // only memory issues (ignoring number of flushes issues).
   // May be called NOT under the flushes_mu_ lock
@@ -396,10 +419,14 @@ class WriteBufferManager final {
   // freed. For that reason we do NOT initiate another flush immediatley once a
   // flush ends, we wait until the total unflushed memory (curr_memory_used -
   // memory_being_freed_) exceeds a threshold.
+  //
+  // With predictive flushes, the memory is forecast to grow by
+  // flush_lookahead_bytes_ until a flush that is initiated now completes.
   bool ShouldInitiateAnotherFlushMemOnly(size_t curr_memory_used) const {
-    return (curr_memory_used - memory_being_freed_ >=
+    const size_t lookahead = flush_lookahead_bytes_;
+    return (curr_memory_used + lookahead - memory_being_freed_ >=
                 additional_flush_step_size_ / 2 &&
-            curr_memory_used >= additional_flush_initiation_size_);
+            curr_memory_used + lookahead >= additional_flush_initiation_size_);
   }
 
   // This should be called only under the flushes_mu_ lock
@@ -449,6 +476,26 @@ class WriteBufferManager final {
 
   std::thread flushes_thread_;
   bool terminate_flushes_thread_ = false;
+
+  // Predictive Flushes Data Members
+
+  SystemClock* clock_ = nullptr;
+  // Protects the ingest and flush duration estimates below
+  std::mutex forecast_mu_;
+  // Bytes reserved since the last ingest rate sample, and the amount of bytes
+  // that triggers a new sample
+  std::atomic<size_t> ingested_bytes_since_sample_ = 0U;
+  std::atomic<size_t> ingest_sample_size_ = 0U;
+  uint64_t last_ingest_sample_time_ = 0U;
+  // EWMA of the ingest rate (bytes / sec) and of the flushes' duration (usec)
+  double ingest_rate_ewma_ = 0.0;
+  double flush_duration_ewma_ = 0.0;
+  // Start times of the running flushes, oldest first
+  std::deque<uint64_t> flush_start_times_;
+  // Bytes expected to be ingested during a flush, capped at
+  // max_flush_lookahead_bytes_
+  std::atomic<size_t> flush_lookahead_bytes_ = 0U;
+  std::atomic<size_t> max_flush_lookahead_bytes_ = 0U;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -41,7 +41,17 @@ public enum CompactionPriority {
    * level. The file picking process will cycle through all the files in a
    * round-robin manner.
    */
-  RoundRobin((byte)0x4);
+  RoundRobin((byte)0x4),
+
+  /**
+   * First compact files with the best ratio between the read amplification
+   * they remove and the bytes the compaction rewrites. The bytes rewritten
+   * are estimated as in MinOverlappingRatio, with the file size compensated
+   * by its deletions. The read benefit grows with the number of sampled reads
+   * that hit the file, so hot key ranges are compacted first. Without reads,
+   * this orders files like MinOverlappingRatio.
+   */
+  ByReadAmpBenefit((byte)0x5);
 
 
   private final byte value;
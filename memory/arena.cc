@@ -33,11 +33,14 @@ size_t Arena::OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
+Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+             bool grow_blocks)
     : kBlockSize(OptimizeBlockSize(block_size)), tracker_(tracker) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   TEST_SYNC_POINT_CALLBACK("Arena::Arena:0", const_cast<size_t*>(&kBlockSize));
+  next_block_size_ =
+      grow_blocks ? std::min(kMinBlockSize, kBlockSize) : kBlockSize;
   alloc_bytes_remaining_ = sizeof(inline_block_);
   blocks_memory_ += alloc_bytes_remaining_;
   aligned_alloc_ptr_ = inline_block_;
@@ -76,7 +79,13 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
     block_head = AllocateFromHugePage(size);
   }
   if (!block_head) {
-    size = kBlockSize;
+    // With growing blocks, skip the sizes that are too small for bytes
+    size = next_block_size_;
+    while (bytes > size / 4 && size < kBlockSize) {
+      size *= 2;
+    }
+    size = std::min(size, kBlockSize);
+    next_block_size_ = std::min(size * 2, kBlockSize);
     block_head = AllocateNewBlock(size);
   }
   alloc_bytes_remaining_ = size - bytes;
@@ -39,8 +39,11 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
+  // grow_blocks: if true, the regular blocks start at kMinBlockSize and
+  // double in size up to block_size.
   explicit Arena(size_t block_size = kMinBlockSize,
-                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0);
+                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0,
+                 bool grow_blocks = false);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -78,6 +81,9 @@ class Arena : public Allocator {
 
   size_t BlockSize() const override { return kBlockSize; }
 
+  // The size of the next regular block
+  size_t NextBlockSize() const { return next_block_size_; }
+
   bool IsInInlineBlock() const {
     return blocks_.empty() && huge_blocks_.empty();
   }
@@ -91,6 +97,9 @@ class Arena : public Allocator {
   alignas(std::max_align_t) char inline_block_[kInlineSize];
   // Number of bytes allocated in one block
   const size_t kBlockSize;
+  // Number of bytes of the next regular block, kBlockSize unless the blocks
+  // grow
+  size_t next_block_size_;
   // Allocated memory blocks
   std::deque<std::unique_ptr<char[]>> blocks_;
   // Huge page allocations
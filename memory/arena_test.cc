@@ -202,6 +202,35 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(kHugePageSize);
 }
 
+TEST_F(ArenaTest, GrowBlocks) {
+  constexpr size_t kBlockSize = 1U << 20;
+  Arena fixed_arena(kBlockSize);
+  Arena growing_arena(kBlockSize, nullptr, 0, true /* grow_blocks */);
+  ASSERT_EQ(fixed_arena.NextBlockSize(), kBlockSize);
+  ASSERT_EQ(growing_arena.NextBlockSize(), Arena::kMinBlockSize);
+
+  // A little more than the inline block
+  for (size_t i = 0; i < 2 * Arena::kInlineSize / 100; ++i) {
+    ASSERT_NE(fixed_arena.Allocate(100), nullptr);
+    ASSERT_NE(growing_arena.Allocate(100), nullptr);
+  }
+  ASSERT_GE(fixed_arena.MemoryAllocatedBytes(), kBlockSize);
+  ASSERT_LT(growing_arena.MemoryAllocatedBytes(), 4 * Arena::kMinBlockSize);
+  ASSERT_EQ(growing_arena.NextBlockSize(), 2 * Arena::kMinBlockSize);
+
+  // An allocation larger than the next block goes to a block big enough for
+  // it, without being an irregular block
+  ASSERT_NE(growing_arena.Allocate(4 * Arena::kMinBlockSize), nullptr);
+  ASSERT_EQ(growing_arena.IrregularBlockNum(), 0);
+  ASSERT_EQ(growing_arena.NextBlockSize(), 32 * Arena::kMinBlockSize);
+
+  // The blocks stop growing at the block size
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_NE(growing_arena.Allocate(kBlockSize / 4), nullptr);
+  }
+  ASSERT_EQ(growing_arena.NextBlockSize(), kBlockSize);
+}
+
 // Number of minor page faults since last call
 size_t PopMinorPageFaultCount() {
 #ifdef RUSAGE_SELF
@@ -41,13 +41,14 @@ class Logger;
 // shard blocks are allocated from the underlying main arena.
 class ConcurrentArena : public Allocator {
  public:
-  // block_size and huge_page_size are the same as for Arena (and are
-  // in fact just passed to the constructor of arena_.  The core-local
-  // shards compute their shard_block_size as a fraction of block_size
-  // that varies according to the hardware concurrency level.
+  // block_size, huge_page_size and grow_blocks are the same as for Arena
+  // (and are in fact just passed to the constructor of arena_.  The
+  // core-local shards compute their shard_block_size as a fraction of
+  // block_size that varies according to the hardware concurrency level, and
+  // of the size of the next block of arena_ if the blocks grow.
   explicit ConcurrentArena(size_t block_size = Arena::kMinBlockSize,
                            AllocTracker* tracker = nullptr,
-                           size_t huge_page_size = 0);
+                           size_t huge_page_size = 0, bool grow_blocks = false);
 
   char* Allocate(size_t bytes) override {
     return AllocateImpl(bytes, false /*force_arena*/,
@@ -179,9 +180,12 @@ class ConcurrentArena : public Allocator {
         return rv;
       }
 
-      avail = exact >= shard_block_size_ / 2 && exact < shard_block_size_ * 2
+      // While the arena blocks grow, so do the shard blocks
+      size_t shard_block_size = std::max(
+          std::min(shard_block_size_, arena_.NextBlockSize() / 8), bytes);
+      avail = exact >= shard_block_size / 2 && exact < shard_block_size * 2
                   ? exact
-                  : shard_block_size_;
+                  : shard_block_size;
       s->free_begin_ = arena_.AllocateAligned(avail);
       Fixup();
     }
@@ -17,6 +17,7 @@
 #include "db/db_impl/db_impl.h"
 #include "monitoring/instrumented_mutex.h"
 #include "rocksdb/status.h"
+#include "rocksdb/system_clock.h"
 #include "test_util/sync_point.h"
 #include "util/coding.h"
 
@@ -29,7 +30,8 @@ auto WriteBufferManager::FlushInitiationOptions::Sanitize() const
     sanitized_max_num_parallel_flushes = kDfltMaxNumParallelFlushes;
   }
 
-  return FlushInitiationOptions(sanitized_max_num_parallel_flushes);
+  return FlushInitiationOptions(sanitized_max_num_parallel_flushes,
+                                predictive_flushes);
 }
 
 WriteBufferManager::WriteBufferManager(
@@ -50,7 +52,8 @@ WriteBufferManager::WriteBufferManager(
       flush_initiation_options_(flush_initiation_options.Sanitize()),
       flushes_mu_(new InstrumentedMutex),
       flushes_initiators_mu_(new InstrumentedMutex),
-      flushes_wakeup_cv_(new InstrumentedCondVar(flushes_mu_.get())) {
+      flushes_wakeup_cv_(new InstrumentedCondVar(flushes_mu_.get())),
+      clock_(SystemClock::Default().get()) {
   if (cache) {
     // Memtable's memory usage tends to fluctuate frequently
     // therefore we set delayed_decrease = true to save some dummy entry
@@ -99,6 +102,9 @@ void WriteBufferManager::ReserveMem(size_t mem) {
   }
   if (is_enabled) {
     UpdateUsageState(new_memory_used, static_cast<int64_t>(mem), buffer_size());
+    if (IsPredictingFlushes()) {
+      UpdateIngestRate(mem);
+    }
     // Checking outside the locks is not reliable, but avoids locking
     // unnecessarily which is expensive
     if (UNLIKELY(ShouldInitiateAnotherFlushMemOnly(new_memory_used))) {
@@ -315,6 +321,11 @@ std::string WriteBufferManager::GetPrintableOptions() const {
            "wbm.initiate_flushes", IsInitiatingFlushes());
   ret.append(buffer);
 
+  snprintf(buffer, kBufferSize, "%*s: %d\n", field_width,
+           "wbm.predictive_flushes",
+           flush_initiation_options_.predictive_flushes);
+  ret.append(buffer);
+
   return ret;
 }
 
@@ -606,6 +617,15 @@ void WriteBufferManager::InitFlushInitiationVars(size_t quota) {
     RecalcFlushInitiationSize();
   }
 
+  if (IsPredictingFlushes()) {
+    std::lock_guard<std::mutex> lock(forecast_mu_);
+    // Flushing earlier than that would initiate flushes of (almost) empty
+    // memtables
+    max_flush_lookahead_bytes_ = additional_flush_step_size_ / 2;
+    ingest_sample_size_ = std::max<size_t>(additional_flush_step_size_ / 8, 1U);
+    RecalcFlushLookahead();
+  }
+
   if (flushes_thread_.joinable() == false) {
     flushes_thread_ =
         std::thread(&WriteBufferManager::InitiateFlushesThread, this);
@@ -722,6 +742,10 @@ void WriteBufferManager::TerminateFlushesThread() {
 }
 
 void WriteBufferManager::FlushStarted(bool wbm_initiated) {
+  if (enabled() && IsPredictingFlushes()) {
+    RecordFlushStart();
+  }
+
   // num_running_flushes_ is incremented in our thread when initiating flushes
   // => Already accounted for
   if (wbm_initiated || !enabled()) {
@@ -741,6 +765,10 @@ void WriteBufferManager::FlushEnded(bool /* wbm_initiated */) {
     return;
   }
 
+  if (IsPredictingFlushes()) {
+    RecordFlushEnd();
+  }
+
   flushes_mu_->Lock();
 
   // The WBM may be enabled after a flush has started. In that case
@@ -841,6 +869,71 @@ bool WriteBufferManager::IsInitiatorIdxValid(uint64_t initiator_idx) const {
   return (initiator_idx < flush_initiators_.size());
 }
 
+void WriteBufferManager::UpdateIngestRate(size_t mem) {
+  constexpr double kIngestRateAlpha = 0.3;
+
+  auto ingested_bytes =
+      ingested_bytes_since_sample_.fetch_add(mem, std::memory_order_relaxed) +
+      mem;
+  if (ingested_bytes < ingest_sample_size_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Another thread is taking the sample, the bytes will count in the next one
+  std::unique_lock<std::mutex> lock(forecast_mu_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+  ingested_bytes = ingested_bytes_since_sample_.exchange(0U);
+  auto now = clock_->NowMicros();
+  if (last_ingest_sample_time_ != 0U && now > last_ingest_sample_time_) {
+    double rate = 1e6 * ingested_bytes /
+                  static_cast<double>(now - last_ingest_sample_time_);
+    ingest_rate_ewma_ =
+        (ingest_rate_ewma_ == 0.0)
+            ? rate
+            : kIngestRateAlpha * rate +
+                  (1 - kIngestRateAlpha) * ingest_rate_ewma_;
+    RecalcFlushLookahead();
+  }
+  last_ingest_sample_time_ = now;
+}
+
+void WriteBufferManager::RecordFlushStart() {
+  std::lock_guard<std::mutex> lock(forecast_mu_);
+  flush_start_times_.push_back(clock_->NowMicros());
+}
+
+void WriteBufferManager::RecordFlushEnd() {
+  constexpr double kFlushDurationAlpha = 0.5;
+
+  std::lock_guard<std::mutex> lock(forecast_mu_);
+  // The WBM may not have seen the start of the flush (see FlushEnded()).
+  // Flushes usually complete in the order they start, so the oldest start
+  // time is a good enough estimate otherwise.
+  if (flush_start_times_.empty()) {
+    return;
+  }
+  auto start_time = flush_start_times_.front();
+  flush_start_times_.pop_front();
+  auto now = clock_->NowMicros();
+  double duration =
+      static_cast<double>(now > start_time ? now - start_time : 0U);
+  flush_duration_ewma_ =
+      (flush_duration_ewma_ == 0.0)
+          ? duration
+          : kFlushDurationAlpha * duration +
+                (1 - kFlushDurationAlpha) * flush_duration_ewma_;
+  RecalcFlushLookahead();
+}
+
+void WriteBufferManager::RecalcFlushLookahead() {
+  auto lookahead = static_cast<size_t>(ingest_rate_ewma_ *
+                                       flush_duration_ewma_ / 1e6);
+  flush_lookahead_bytes_ =
+      std::min<size_t>(lookahead, max_flush_lookahead_bytes_);
+}
+
 void WriteBufferManager::TEST_WakeupFlushInitiationThread() {
   WakeupFlushInitiationThreadNoLockHeld();
 }
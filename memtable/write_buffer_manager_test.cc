@@ -18,6 +18,7 @@
 
 #include "rocksdb/advanced_cache.h"
 #include "rocksdb/cache.h"
+#include "test_util/mock_time_env.h"
 #include "test_util/sync_point.h"
 #include "test_util/testharness.h"
 
@@ -318,6 +319,53 @@ TEST_F(ChargeWriteBufferTest, BasicWithCacheFull) {
             46 * kSizeDummyEntry + kMetaDataChargeOverhead);
 }
 
+TEST_F(WriteBufferManagerTest, PredictiveFlushes) {
+  constexpr size_t kMB = 1024 * 1024;
+  constexpr size_t kQuota = 100 * kMB;
+  // 4 parallel flushes => flush step of 20MB, lookahead is capped at 10MB and
+  // the ingest rate is sampled every 2.5MB
+  WriteBufferManager::FlushInitiationOptions initiation_options(
+      4U /* max_num_parallel_flushes */, true /* predictive_flushes */);
+  std::unique_ptr<WriteBufferManager> wbf(new WriteBufferManager(
+      kQuota, nullptr /* cache */, false /* allow_stall */,
+      true /* initiate_flushes */, initiation_options));
+  ASSERT_TRUE(wbf->GetFlushInitiationOptions().predictive_flushes);
+
+  auto clock = std::make_shared<MockSystemClock>(SystemClock::Default());
+  clock->SetCurrentTime(1);
+  wbf->TEST_SetClock(clock.get());
+
+  // A flush that takes 2 seconds
+  wbf->FlushStarted(false /* wbm_initiated */);
+  clock->SetCurrentTime(3);
+  wbf->FlushEnded(false /* wbm_initiated */);
+  ASSERT_EQ(wbf->TEST_GetFlushLookaheadBytes(), 0U);
+
+  // Ingest 3MB/s
+  for (auto i = 0; i < 3; ++i) {
+    wbf->ReserveMem(kMB);
+  }
+  clock->SetCurrentTime(4);
+  for (auto i = 0; i < 3; ++i) {
+    wbf->ReserveMem(kMB);
+  }
+  ASSERT_EQ(wbf->TEST_GetFlushLookaheadBytes(), 6 * kMB);
+  ASSERT_EQ(wbf->TEST_GetNumFlushesToInitiate(), 0U);
+
+  // 14MB are used, the first flush step (20MB) is expected to be reached
+  // while a flush runs => a flush is initiated
+  wbf->ReserveMem(8 * kMB);
+  ASSERT_EQ(wbf->TEST_GetFlushLookaheadBytes(), 6 * kMB);
+  ASSERT_EQ(wbf->TEST_GetNumFlushesToInitiate(), 1U);
+
+  // A burst, the lookahead is capped at half a flush step
+  clock->SetCurrentTime(5);
+  wbf->ReserveMem(30 * kMB);
+  ASSERT_EQ(wbf->TEST_GetFlushLookaheadBytes(), 10 * kMB);
+
+  ScheduleBeginAndFreeMem(*wbf, 44 * kMB);
+}
+
 #define VALIDATE_USAGE_STATE(memory_change_size, expected_state,   \
                              expected_factor)                      \
   ValidateUsageState(__LINE__, memory_change_size, expected_state, \
@@ -74,6 +74,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableDBOptions, max_subcompactions),
           OptionType::kUInt32T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"subcompaction_ranges_per_thread",
+         {offsetof(struct MutableDBOptions, subcompaction_ranges_per_thread),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"avoid_flush_during_shutdown",
          {offsetof(struct MutableDBOptions, avoid_flush_during_shutdown),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -183,6 +187,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"allow_2pc",
          {offsetof(struct ImmutableDBOptions, allow_2pc), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+        {"row_cache_frequency_admission",
+         {offsetof(struct ImmutableDBOptions, row_cache_frequency_admission),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"wal_filter",
          OptionTypeInfo::AsCustomRawPtr<WalFilter>(
              offsetof(struct ImmutableDBOptions, wal_filter),
@@ -270,6 +278,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, max_file_opening_threads),
           OptionType::kInt, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"pin_table_readers_up_to_half_table_cache",
+         {offsetof(struct ImmutableDBOptions,
+                   pin_table_readers_up_to_half_table_cache),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"table_cache_numshardbits",
          {offsetof(struct ImmutableDBOptions, table_cache_numshardbits),
           OptionType::kInt, OptionVerificationType::kNormal,
@@ -374,6 +387,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, dump_malloc_stats),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"enable_pipelined_wal_recovery",
+         {offsetof(struct ImmutableDBOptions, enable_pipelined_wal_recovery),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"avoid_flush_during_recovery",
          {offsetof(struct ImmutableDBOptions, avoid_flush_during_recovery),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -575,6 +592,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, use_dynamic_delay),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"write_controller_weight",
+         {offsetof(struct ImmutableDBOptions, write_controller_weight),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"use_clean_delete_during_flush",
          {offsetof(struct ImmutableDBOptions, use_clean_delete_during_flush),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -710,6 +731,8 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       info_log(options.info_log),
       info_log_level(options.info_log_level),
       max_file_opening_threads(options.max_file_opening_threads),
+      pin_table_readers_up_to_half_table_cache(
+          options.pin_table_readers_up_to_half_table_cache),
       statistics(options.statistics),
       use_fsync(options.use_fsync),
       db_paths(options.db_paths),
@@ -756,10 +779,12 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       wal_recovery_mode(options.wal_recovery_mode),
       allow_2pc(options.allow_2pc),
       row_cache(options.row_cache),
+      row_cache_frequency_admission(options.row_cache_frequency_admission),
       wal_filter(options.wal_filter),
       fail_if_options_file_error(options.fail_if_options_file_error),
       dump_malloc_stats(options.dump_malloc_stats),
       avoid_flush_during_recovery(options.avoid_flush_during_recovery),
+      enable_pipelined_wal_recovery(options.enable_pipelined_wal_recovery),
       allow_ingest_behind(options.allow_ingest_behind),
       two_write_queues(options.two_write_queues),
       manual_wal_flush(options.manual_wal_flush),
@@ -779,6 +804,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       lowest_used_cache_tier(options.lowest_used_cache_tier),
       compaction_service(options.compaction_service),
       use_dynamic_delay(options.use_dynamic_delay),
+      write_controller_weight(options.write_controller_weight),
       enforce_single_del_contracts(options.enforce_single_del_contracts),
       use_clean_delete_during_flush(options.use_clean_delete_during_flush) {
   fs = env->GetFileSystem();
@@ -810,6 +836,9 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    info_log.get());
   ROCKS_LOG_HEADER(log, "               Options.max_file_opening_threads: %d",
                    max_file_opening_threads);
+  ROCKS_LOG_HEADER(log,
+                   "Options.pin_table_readers_up_to_half_table_cache: %d",
+                   pin_table_readers_up_to_half_table_cache);
   ROCKS_LOG_HEADER(log, "                             Options.statistics: %p",
                    stats);
   ROCKS_LOG_HEADER(log, "                              Options.use_fsync: %d",
@@ -868,6 +897,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    advise_random_on_open);
   ROCKS_LOG_HEADER(log, "                      Options.use_dynamic_delay: %d",
                    use_dynamic_delay);
+  ROCKS_LOG_HEADER(log, "                Options.write_controller_weight: %u",
+                   write_controller_weight);
   ROCKS_LOG_HEADER(log, "                   Options.write_controller: %p",
                    write_controller.get());
   ROCKS_LOG_HEADER(
@@ -915,6 +946,9 @@ void ImmutableDBOptions::Dump(Logger* log) const {
         log,
         "                              Options.row_cache: %" ROCKSDB_PRIszt,
         row_cache->GetCapacity());
+    ROCKS_LOG_HEADER(
+        log, "          Options.row_cache_frequency_admission: %d",
+        row_cache_frequency_admission);
   } else {
     ROCKS_LOG_HEADER(log,
                      "                              Options.row_cache: None");
@@ -924,6 +958,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
 
   ROCKS_LOG_HEADER(log, "            Options.avoid_flush_during_recovery: %d",
                    avoid_flush_during_recovery);
+  ROCKS_LOG_HEADER(log, "          Options.enable_pipelined_wal_recovery: %d",
+                   enable_pipelined_wal_recovery);
   ROCKS_LOG_HEADER(log, "            Options.allow_ingest_behind: %d",
                    allow_ingest_behind);
   ROCKS_LOG_HEADER(log, "            Options.two_write_queues: %d",
@@ -1002,6 +1038,7 @@ MutableDBOptions::MutableDBOptions()
     : max_background_jobs(2),
       max_background_compactions(-1),
       max_subcompactions(0),
+      subcompaction_ranges_per_thread(1),
       avoid_flush_during_shutdown(false),
       writable_file_max_buffer_size(1024 * 1024),
       delayed_write_rate(2 * 1024U * 1024U),
@@ -1022,6 +1059,7 @@ MutableDBOptions::MutableDBOptions(const DBOptions& options)
     : max_background_jobs(options.max_background_jobs),
       max_background_compactions(options.max_background_compactions),
       max_subcompactions(options.max_subcompactions),
+      subcompaction_ranges_per_thread(options.subcompaction_ranges_per_thread),
       avoid_flush_during_shutdown(options.avoid_flush_during_shutdown),
       writable_file_max_buffer_size(options.writable_file_max_buffer_size),
       delayed_write_rate(options.delayed_write_rate),
@@ -1047,6 +1085,9 @@ void MutableDBOptions::Dump(Logger* log) const {
                    max_background_compactions);
   ROCKS_LOG_HEADER(log, "            Options.max_subcompactions: %" PRIu32,
                    max_subcompactions);
+  ROCKS_LOG_HEADER(
+      log, "            Options.subcompaction_ranges_per_thread: %" PRIu32,
+      subcompaction_ranges_per_thread);
   ROCKS_LOG_HEADER(log, "            Options.avoid_flush_during_shutdown: %d",
                    avoid_flush_during_shutdown);
   ROCKS_LOG_HEADER(
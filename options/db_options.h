@@ -33,6 +33,7 @@ struct ImmutableDBOptions {
   std::shared_ptr<Logger> info_log;
   InfoLogLevel info_log_level;
   int max_file_opening_threads;
+  bool pin_table_readers_up_to_half_table_cache;
   std::shared_ptr<Statistics> statistics;
   bool use_fsync;
   std::vector<DbPath> db_paths;
@@ -78,10 +79,12 @@ struct ImmutableDBOptions {
   WALRecoveryMode wal_recovery_mode;
   bool allow_2pc;
   std::shared_ptr<Cache> row_cache;
+  bool row_cache_frequency_admission;
   WalFilter* wal_filter;
   bool fail_if_options_file_error;
   bool dump_malloc_stats;
   bool avoid_flush_during_recovery;
+  bool enable_pipelined_wal_recovery;
   bool allow_ingest_behind;
   bool two_write_queues;
   bool manual_wal_flush;
@@ -106,6 +109,7 @@ struct ImmutableDBOptions {
   Logger* logger;
   std::shared_ptr<CompactionService> compaction_service;
   bool use_dynamic_delay;
+  uint32_t write_controller_weight;
   bool enforce_single_del_contracts;
   bool use_clean_delete_during_flush;
 
@@ -125,6 +129,7 @@ struct MutableDBOptions {
   int max_background_jobs;
   int max_background_compactions;
   uint32_t max_subcompactions;
+  uint32_t subcompaction_ranges_per_thread;
   bool avoid_flush_during_shutdown;
   size_t writable_file_max_buffer_size;
   uint64_t delayed_write_rate;
@@ -60,6 +60,7 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
           options.memtable_insert_with_hint_prefix_extractor),
       bloom_locality(options.bloom_locality),
       arena_block_size(options.arena_block_size),
+      memtable_grow_arena_blocks(options.memtable_grow_arena_blocks),
       compression_per_level(options.compression_per_level),
       num_levels(options.num_levels),
       level0_slowdown_writes_trigger(options.level0_slowdown_writes_trigger),
@@ -107,6 +108,8 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
           options.blob_garbage_collection_age_cutoff),
       blob_garbage_collection_force_threshold(
           options.blob_garbage_collection_force_threshold),
+      blob_garbage_collection_force_max_batches(
+          options.blob_garbage_collection_force_max_batches),
       blob_compaction_readahead_size(options.blob_compaction_readahead_size),
       blob_file_starting_level(options.blob_file_starting_level),
       blob_cache(options.blob_cache),
@@ -290,6 +293,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
         log,
         "                       Options.arena_block_size: %" ROCKSDB_PRIszt,
         arena_block_size);
+    ROCKS_LOG_HEADER(log,
+                     "             Options.memtable_grow_arena_blocks: %d",
+                     memtable_grow_arena_blocks);
     ROCKS_LOG_HEADER(log,
                      "  Options.soft_pending_compaction_bytes_limit: %" PRIu64,
                      soft_pending_compaction_bytes_limit);
@@ -427,6 +433,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      blob_garbage_collection_age_cutoff);
     ROCKS_LOG_HEADER(log, "Options.blob_garbage_collection_force_threshold: %f",
                      blob_garbage_collection_force_threshold);
+    ROCKS_LOG_HEADER(
+        log, "Options.blob_garbage_collection_force_max_batches: %" PRIu32,
+        blob_garbage_collection_force_max_batches);
     ROCKS_LOG_HEADER(
         log, "         Options.blob_compaction_readahead_size: %" PRIu64,
         blob_compaction_readahead_size);
@@ -684,6 +693,7 @@ ReadOptions::ReadOptions()
       iterate_lower_bound(nullptr),
       iterate_upper_bound(nullptr),
       readahead_size(0),
+      blob_readahead_size(0),
       max_skippable_internal_keys(0),
       read_tier(kReadAllTier),
       verify_checksums(true),
@@ -710,6 +720,7 @@ ReadOptions::ReadOptions(bool cksum, bool cache)
       iterate_lower_bound(nullptr),
       iterate_upper_bound(nullptr),
       readahead_size(0),
+      blob_readahead_size(0),
       max_skippable_internal_keys(0),
       read_tier(kReadAllTier),
       verify_checksums(cksum),
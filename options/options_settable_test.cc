@@ -201,7 +201,8 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "max_auto_readahead_size=0;"
       "prepopulate_block_cache=kDisable;"
       "initial_auto_readahead_size=0;"
-      "num_file_reads_for_auto_readahead=0",
+      "num_file_reads_for_auto_readahead=0;"
+      "max_auto_readahead_gap_size=0",
       new_bbto));
 
   ASSERT_EQ(unset_bytes_base,
@@ -294,9 +295,11 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "wal_dir=path/to/wal_dir;"
                              "db_write_buffer_size=2587;"
                              "max_subcompactions=64330;"
+                             "subcompaction_ranges_per_thread=4;"
                              "table_cache_numshardbits=28;"
                              "max_open_files=72;"
                              "max_file_opening_threads=35;"
+                             "pin_table_readers_up_to_half_table_cache=true;"
                              "max_background_jobs=8;"
                              "max_background_compactions=33;"
                              "use_fsync=true;"
@@ -349,7 +352,9 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "info_log_level=DEBUG_LEVEL;"
                              "dump_malloc_stats=false;"
                              "allow_2pc=false;"
+                             "row_cache_frequency_admission=true;"
                              "avoid_flush_during_recovery=false;"
+                             "enable_pipelined_wal_recovery=true;"
                              "avoid_flush_during_shutdown=false;"
                              "allow_ingest_behind=false;"
                              "concurrent_prepare=false;"
@@ -371,6 +376,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "refresh_options_sec=0;"
                              "refresh_options_file=Options.new;"
                              "use_dynamic_delay=true;"
+                             "write_controller_weight=1;"
                              "use_clean_delete_during_flush=false;",
                              new_options));
 
@@ -495,6 +501,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "max_successive_merges=5497;"
       "max_sequential_skip_in_iterations=4294971408;"
       "arena_block_size=1893;"
+      "memtable_grow_arena_blocks=true;"
       "target_file_size_multiplier=35;"
       "min_write_buffer_number_to_merge=9;"
       "max_write_buffer_number=84;"
@@ -543,6 +550,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "enable_blob_garbage_collection=true;"
       "blob_garbage_collection_age_cutoff=0.5;"
       "blob_garbage_collection_force_threshold=0.75;"
+      "blob_garbage_collection_force_max_batches=2;"
       "blob_compaction_readahead_size=262144;"
       "blob_file_starting_level=1;"
       "prepopulate_blob_cache=kDisable;"
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <list>
 #include <vector>
 
@@ -323,24 +324,25 @@ bool SpdbVectorContainer::IsEmpty() const { return num_elements_.load() == 0; }
 bool SpdbVectorContainer::InitIterator(IterAnchors& iter_anchor) {
   bool immutable = immutable_.load();
 
-  auto last_iter = curr_vector_.load()->GetVectorListIter();
   bool notify_sort_thread = false;
-  if (!immutable) {
-    if (!(*last_iter)->IsEmpty()) {
-      {
-        MutexLock l(&spdb_vectors_mutex_);
+  {
+    // the sort thread may replace sorted vectors with their merged run
+    MutexLock l(&spdb_vectors_mutex_);
+    auto last_iter = curr_vector_.load()->GetVectorListIter();
+    if (!immutable) {
+      if (!(*last_iter)->IsEmpty()) {
         SpdbVectorPtr spdb_vector(new SpdbVector(switch_spdb_vector_limit_));
         spdb_vectors_.push_back(spdb_vector);
         spdb_vector->SetVectorListIter(std::prev(spdb_vectors_.end()));
         curr_vector_.store(spdb_vector.get());
+        notify_sort_thread = true;
+      } else {
+        --last_iter;
       }
-      notify_sort_thread = true;
-    } else {
-      --last_iter;
     }
+    ++last_iter;
+    InitIterator(iter_anchor, spdb_vectors_.begin(), last_iter);
   }
-  ++last_iter;
-  InitIterator(iter_anchor, spdb_vectors_.begin(), last_iter);
   if (!immutable) {
     if (notify_sort_thread) {
       sort_thread_cv_.notify_one();
@@ -395,6 +397,60 @@ void SpdbVectorContainer::SortThread() {
     for (; sort_iter_anchor != last; ++sort_iter_anchor) {
       (*sort_iter_anchor)->Sort(comparator_);
     }
+    // all the vectors before the anchor are sorted and immutable. the merge
+    // is done without the sort thread mutex so MarkReadOnly() isn't delayed
+    lck.unlock();
+    MergeSortedVectors(sort_iter_anchor);
+    lck.lock();
+    if (immutable_) {
+      break;
+    }
+  }
+}
+
+void SpdbVectorContainer::MergeSortedVectors(
+    std::list<SpdbVectorPtr>::iterator last) {
+  // Like a binary counter, the newest run is merged with its older neighbour
+  // as long as the older one isn't bigger. This keeps the number of runs
+  // logarithmic in the number of inserted keys while every key is merged a
+  // logarithmic number of times.
+  while (!immutable_.load()) {
+    std::list<SpdbVectorPtr>::iterator older_iter;
+    std::list<SpdbVectorPtr>::iterator newer_iter;
+    SpdbVectorPtr older;
+    SpdbVectorPtr newer;
+    {
+      MutexLock l(&spdb_vectors_mutex_);
+      if (last == spdb_vectors_.begin()) {
+        return;
+      }
+      newer_iter = std::prev(last);
+      if (newer_iter == spdb_vectors_.begin()) {
+        return;
+      }
+      older_iter = std::prev(newer_iter);
+      older = *older_iter;
+      newer = *newer_iter;
+    }
+    if (!older->IsSorted() || !newer->IsSorted() ||
+        older->Size() > newer->Size()) {
+      return;
+    }
+
+    const size_t merged_size = older->Size() + newer->Size();
+    SpdbVector::Vec merged;
+    merged.reserve(merged_size);
+    std::merge(older->Begin(), older->End(), newer->Begin(), newer->End(),
+               std::back_inserter(merged), stl_wrappers::Compare(comparator_));
+    SpdbVectorPtr merged_vector(new SpdbVector(std::move(merged), merged_size));
+
+    // existing iterators keep a reference to the vectors they were created
+    // with, so the merged vectors can be removed from the list
+    MutexLock l(&spdb_vectors_mutex_);
+    auto merged_iter = spdb_vectors_.insert(older_iter, merged_vector);
+    merged_vector->SetVectorListIter(merged_iter);
+    spdb_vectors_.erase(older_iter);
+    spdb_vectors_.erase(newer_iter);
   }
 }
 
@@ -0,0 +1,380 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "plugin/speedb/memtable/sharded_skiplist_rep.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "memtable/inlineskiplist.h"
+#include "port/port.h"
+#include "rocksdb/utilities/options_type.h"
+#include "test_util/sync_point.h"
+#include "util/heap.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+using ShardSkipList = InlineSkipList<const MemTableRep::KeyComparator&>;
+
+struct ALIGN_AS(CACHE_LINE_SIZE) SkipListShard {
+  SkipListShard(const MemTableRep::KeyComparator& compare,
+                Allocator* allocator)
+      : skip_list(compare, allocator) {}
+
+  ShardSkipList skip_list;
+};
+
+// Merges the iterators of all the shards. Keys are unique across the shards
+// (each key is inserted once), so no de-duplication is needed.
+class ShardedSkipListIterator : public MemTableRep::Iterator {
+ public:
+  ShardedSkipListIterator(
+      const std::vector<std::unique_ptr<SkipListShard>>& shards,
+      const MemTableRep::KeyComparator& compare)
+      : compare_(compare),
+        min_heap_(MinIterComparator(compare)),
+        max_heap_(MaxIterComparator(compare)) {
+    children_.reserve(shards.size());
+    for (const auto& shard : shards) {
+      children_.emplace_back(&shard->skip_list);
+    }
+  }
+
+  bool Valid() const override { return current_ != nullptr; }
+
+  const char* key() const override {
+    assert(Valid());
+    return current_->key();
+  }
+
+  void Next() override {
+    assert(Valid());
+    if (!forward_) {
+      // The other children are positioned before key(), move them after it
+      SwitchDirection(true /* forward */);
+    }
+    current_->Next();
+    if (current_->Valid()) {
+      min_heap_.replace_top(current_);
+    } else {
+      min_heap_.pop();
+    }
+    current_ = min_heap_.empty() ? nullptr : min_heap_.top();
+  }
+
+  void Prev() override {
+    assert(Valid());
+    if (forward_) {
+      SwitchDirection(false /* forward */);
+    }
+    current_->Prev();
+    if (current_->Valid()) {
+      max_heap_.replace_top(current_);
+    } else {
+      max_heap_.pop();
+    }
+    current_ = max_heap_.empty() ? nullptr : max_heap_.top();
+  }
+
+  void Seek(const Slice& internal_key, const char* memtable_key) override {
+    const char* encoded_key = (memtable_key != nullptr)
+                                  ? memtable_key
+                                  : EncodeKey(&tmp_, internal_key);
+    for (auto& child : children_) {
+      child.Seek(encoded_key);
+    }
+    BuildMinHeap();
+  }
+
+  void SeekForPrev(const Slice& internal_key,
+                   const char* memtable_key) override {
+    const char* encoded_key = (memtable_key != nullptr)
+                                  ? memtable_key
+                                  : EncodeKey(&tmp_, internal_key);
+    for (auto& child : children_) {
+      child.SeekForPrev(encoded_key);
+    }
+    BuildMaxHeap();
+  }
+
+  void SeekToFirst() override {
+    for (auto& child : children_) {
+      child.SeekToFirst();
+    }
+    BuildMinHeap();
+  }
+
+  void SeekToLast() override {
+    for (auto& child : children_) {
+      child.SeekToLast();
+    }
+    BuildMaxHeap();
+  }
+
+ private:
+  struct MinIterComparator {
+    explicit MinIterComparator(const MemTableRep::KeyComparator& compare)
+        : compare_(compare) {}
+    bool operator()(const ShardSkipList::Iterator* a,
+                    const ShardSkipList::Iterator* b) const {
+      return compare_(a->key(), b->key()) > 0;
+    }
+    const MemTableRep::KeyComparator& compare_;
+  };
+
+  struct MaxIterComparator {
+    explicit MaxIterComparator(const MemTableRep::KeyComparator& compare)
+        : compare_(compare) {}
+    bool operator()(const ShardSkipList::Iterator* a,
+                    const ShardSkipList::Iterator* b) const {
+      return compare_(a->key(), b->key()) < 0;
+    }
+    const MemTableRep::KeyComparator& compare_;
+  };
+
+  void BuildMinHeap() {
+    forward_ = true;
+    min_heap_.clear();
+    for (auto& child : children_) {
+      if (child.Valid()) {
+        min_heap_.push(&child);
+      }
+    }
+    current_ = min_heap_.empty() ? nullptr : min_heap_.top();
+  }
+
+  void BuildMaxHeap() {
+    forward_ = false;
+    max_heap_.clear();
+    for (auto& child : children_) {
+      if (child.Valid()) {
+        max_heap_.push(&child);
+      }
+    }
+    current_ = max_heap_.empty() ? nullptr : max_heap_.top();
+  }
+
+  // Positions all the children around the current key, keeping current_ on
+  // it, and rebuilds the heap of the new direction
+  void SwitchDirection(bool forward) {
+    const char* target = current_->key();
+    for (auto& child : children_) {
+      if (&child == current_) {
+        continue;
+      }
+      if (forward) {
+        child.Seek(target);
+      } else {
+        child.SeekForPrev(target);
+      }
+    }
+    if (forward) {
+      BuildMinHeap();
+    } else {
+      BuildMaxHeap();
+    }
+    assert(current_ != nullptr && compare_(current_->key(), target) == 0);
+  }
+
+  const MemTableRep::KeyComparator& compare_;
+  std::vector<ShardSkipList::Iterator> children_;
+  BinaryHeap<ShardSkipList::Iterator*, MinIterComparator> min_heap_;
+  BinaryHeap<ShardSkipList::Iterator*, MaxIterComparator> max_heap_;
+  ShardSkipList::Iterator* current_ = nullptr;
+  bool forward_ = true;
+  std::string tmp_;  // For passing to EncodeKey
+};
+
+class ShardedSkipListRep : public MemTableRep {
+ public:
+  ShardedSkipListRep(const MemTableRep::KeyComparator& compare,
+                     Allocator* allocator, size_t num_shards)
+      : MemTableRep(allocator), compare_(compare) {
+    assert(num_shards > 0);
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+      shards_.emplace_back(new SkipListShard(compare, allocator));
+    }
+  }
+
+  // The nodes of all the shards have the same layout (same max height), so a
+  // key that was allocated by one shard may be inserted into another, in case
+  // the thread moved to another core in between.
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    *buf = CurrentShard().AllocateKey(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    CurrentShard().Insert(static_cast<char*>(handle));
+  }
+
+  bool InsertKey(KeyHandle handle) override {
+    return CurrentShard().Insert(static_cast<char*>(handle));
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    CurrentShard().InsertConcurrently(static_cast<char*>(handle));
+  }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    return CurrentShard().InsertConcurrently(static_cast<char*>(handle));
+  }
+
+  bool Contains(const char* key) const override {
+    for (const auto& shard : shards_) {
+      if (shard->skip_list.Contains(key)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    if (shards_.size() == 1) {
+      ShardSkipList::Iterator iter(&shards_[0]->skip_list);
+      for (iter.Seek(k.memtable_key().data());
+           iter.Valid() && callback_func(callback_args, iter.key());
+           iter.Next()) {
+      }
+      return;
+    }
+    ShardedSkipListIterator iter(shards_, compare_);
+    Slice dummy_slice;
+    for (iter.Seek(dummy_slice, k.memtable_key().data());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t num_entries = 0;
+    for (const auto& shard : shards_) {
+      uint64_t start_count =
+          shard->skip_list.EstimateCount(EncodeKey(&tmp, start_ikey));
+      uint64_t end_count =
+          shard->skip_list.EstimateCount(EncodeKey(&tmp, end_ikey));
+      num_entries += (end_count >= start_count) ? (end_count - start_count) : 0;
+    }
+    return num_entries;
+  }
+
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    entries->clear();
+    // Avoid divide-by-0.
+    assert(target_sample_size > 0);
+    assert(num_entries > 0);
+    // Iterate linearly through the entries, adding entry i to the sample set
+    // with a probability (target_sample_size - entries.size()) / (N - i).
+    ShardedSkipListIterator iter(shards_, compare_);
+    Random* rnd = Random::GetTLSInstance();
+    iter.SeekToFirst();
+    uint64_t counter = 0, num_samples_left = target_sample_size;
+    for (; iter.Valid() && (num_samples_left > 0) && (counter < num_entries);
+         iter.Next(), counter++) {
+      if (rnd->Next() % (num_entries - counter) < num_samples_left) {
+        entries->insert(iter.key());
+        num_samples_left--;
+      }
+    }
+  }
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(ShardedSkipListIterator))
+                      : operator new(sizeof(ShardedSkipListIterator));
+    return new (mem) ShardedSkipListIterator(shards_, compare_);
+  }
+
+ private:
+  ShardSkipList& CurrentShard() {
+    int core_idx = port::PhysicalCoreID();
+    if (core_idx < 0) {
+      // Unsupported platform, spread the threads randomly
+      core_idx = Random::GetTLSInstance()->Uniform(
+          static_cast<int>(shards_.size()));
+    }
+    TEST_SYNC_POINT_CALLBACK("ShardedSkipListRep::CurrentShard", &core_idx);
+    return shards_[static_cast<size_t>(core_idx) % shards_.size()]->skip_list;
+  }
+
+  const MemTableRep::KeyComparator& compare_;
+  std::vector<std::unique_ptr<SkipListShard>> shards_;
+};
+
+static std::unordered_map<std::string, OptionTypeInfo>
+    sharded_skiplist_factory_info = {
+        {"num_shards",
+         {0, OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kDontSerialize /*Since it is part of the ID*/}},
+};
+
+size_t SanitizeNumShards(size_t num_shards) {
+  if (num_shards == 0) {
+    num_shards = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  return std::min(num_shards,
+                  size_t{ShardedSkipListRepFactory::kMaxNumShards});
+}
+}  // namespace
+
+// ShardedSkipListRepFactory
+
+ShardedSkipListRepFactory::ShardedSkipListRepFactory(size_t num_shards)
+    : num_shards_(SanitizeNumShards(num_shards)) {
+  RegisterOptions("", &num_shards_, &sharded_skiplist_factory_info);
+}
+
+Status ShardedSkipListRepFactory::PrepareOptions(
+    const ConfigOptions& config_options) {
+  // num_shards may have been configured after the constructor sanitized it
+  num_shards_ = SanitizeNumShards(num_shards_);
+  return MemTableRepFactory::PrepareOptions(config_options);
+}
+
+Status ShardedSkipListRepFactory::ValidateOptions(
+    const DBOptions& db_opts, const ColumnFamilyOptions& cf_opts) const {
+  // 0 stays valid without PrepareOptions(), it means a shard per hardware
+  // thread
+  if (num_shards_ > kMaxNumShards) {
+    return Status::InvalidArgument("num_shards must be at most " +
+                                   std::to_string(kMaxNumShards));
+  }
+  return MemTableRepFactory::ValidateOptions(db_opts, cf_opts);
+}
+
+MemTableRep* ShardedSkipListRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* /*transform*/, Logger* /*logger*/) {
+  // Without PrepareOptions() num_shards may not be sanitized yet
+  return new ShardedSkipListRep(compare, allocator,
+                                SanitizeNumShards(num_shards_));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
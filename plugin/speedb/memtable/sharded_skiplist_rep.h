@@ -0,0 +1,59 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "rocksdb/memtablerep.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A memtable made of num_shards skip lists. Every insert goes to the skip
+// list of the core the inserting thread runs on, so concurrent inserters
+// (allow_concurrent_memtable_write) don't contend on the upper levels of a
+// single skip list. Reads merge the skip lists, so Get() and Seek() cost
+// a seek per shard.
+//
+// num_shards == 0 means a shard per hardware thread, and num_shards is at
+// most kMaxNumShards. A num_shards configured through the options framework
+// (e.g. "id=speedb.ShardedSkipListRepFactory;num_shards=0") is sanitized
+// the same way by PrepareOptions().
+class ShardedSkipListRepFactory : public MemTableRepFactory {
+ public:
+  static constexpr size_t kMaxNumShards = 128U;
+
+  explicit ShardedSkipListRepFactory(size_t num_shards = 0);
+
+  using MemTableRepFactory::CreateMemTableRep;
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator& compare,
+                                 Allocator* allocator,
+                                 const SliceTransform* transform,
+                                 Logger* logger) override;
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+  Status PrepareOptions(const ConfigOptions& config_options) override;
+  Status ValidateOptions(const DBOptions& db_opts,
+                         const ColumnFamilyOptions& cf_opts) const override;
+
+  static const char* kClassName() {
+    return "speedb.ShardedSkipListRepFactory";
+  }
+  const char* Name() const override { return kClassName(); }
+
+  size_t GetNumShards() const { return num_shards_; }
+
+ private:
+  size_t num_shards_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -52,6 +52,8 @@ class SpdbVector {
 
   bool IsEmpty() const { return n_elements_ == 0; }
 
+  bool IsSorted() const { return sorted_.load(std::memory_order_acquire); }
+
   bool Sort(const MemTableRep::KeyComparator& comparator);
 
   // find the first element that is >= the given key
@@ -83,6 +85,8 @@ class SpdbVector {
 
   size_t Size() const { return n_elements_; }
 
+  Iterator Begin() { return items_.begin(); }
+
   Iterator End() { return items_.end(); }
 
  private:
@@ -236,6 +240,10 @@ class SpdbVectorContainer {
  private:
   void SortThread();
 
+  // Merge neighbouring sorted vectors before last into bigger sorted runs, so
+  // iterators have fewer vectors to seek and heap-merge
+  void MergeSortedVectors(std::list<SpdbVectorPtr>::iterator last);
+
  private:
   port::RWMutexWr spdb_vectors_add_rwlock_;
   port::Mutex spdb_vectors_mutex_;
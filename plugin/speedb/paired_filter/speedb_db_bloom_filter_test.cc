@@ -2718,6 +2718,48 @@ TEST_F(SpdbDBBloomFilterTest, DynamicBloomFilterOptions) {
   ASSERT_EQ(TestGetTickerCount(options, BLOOM_FILTER_PREFIX_USEFUL), 3);
 }
 
+TEST_F(SpdbDBBloomFilterTest, MultiGetBatchedProbe) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy = Create(20, kSpdbPairedBloom);
+  table_options.whole_key_filtering = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 2000;
+  for (int i = 0; i < kNumKeys; i += 2) {
+    ASSERT_OK(Put(Key(i), "val" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+
+  // Batches of different sizes, with existing and missing keys
+  for (int batch_size : {1, 7, 16, 32}) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < batch_size; ++i) {
+      keys.push_back(Key(i * 61 % kNumKeys));
+    }
+    uint64_t useful_before = TestGetTickerCount(options, BLOOM_FILTER_USEFUL);
+    int num_missing = 0;
+    auto values = MultiGet(keys);
+    ASSERT_EQ(static_cast<size_t>(batch_size), values.size());
+    for (int i = 0; i < batch_size; ++i) {
+      int key_id = i * 61 % kNumKeys;
+      if (key_id % 2 == 0) {
+        ASSERT_EQ("val" + std::to_string(key_id), values[i]);
+      } else {
+        ASSERT_EQ("NOT_FOUND", values[i]);
+        ++num_missing;
+      }
+    }
+    // With 20 bits per key, (almost) all the missing keys are filtered
+    uint64_t useful =
+        TestGetTickerCount(options, BLOOM_FILTER_USEFUL) - useful_before;
+    ASSERT_LE(useful, static_cast<uint64_t>(num_missing));
+    ASSERT_GE(useful + 1, static_cast<uint64_t>(num_missing));
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
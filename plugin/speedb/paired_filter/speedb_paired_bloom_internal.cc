@@ -24,6 +24,7 @@
 
 #include "port/likely.h"  // for LIKELY
 #include "port/port.h"    // for PREFETCH
+#include "table/multiget_context.h"
 #include "test_util/sync_point.h"
 #include "util/bloom_impl.h"
 #include "util/fastrange.h"
@@ -850,12 +851,65 @@ bool SpdbPairedBloomBitsReader::MayMatch(const Slice& key) {
   return HashMayMatch(hash);
 }
 
-// TODO: COPY Rocksdb's approach for multi-keys to improve performance
-// (prefetch blocks)
+// The keys are probed in passes, similar to FastLocalBloomBitsReader, so that
+// the cache misses on the blocks of all the keys overlap instead of being
+// taken one key after the other:
+// 1. Hash all the keys and prefetch their primary blocks
+// 2. Check the primary blocks and prefetch the secondary blocks of the keys
+//    that may still match
+// 3. Check the secondary blocks
 void SpdbPairedBloomBitsReader::MayMatch(int num_keys, Slice** keys,
                                          bool* may_match) {
+  struct PreparedKey {
+    uint32_t upper_32_bits_of_hash;
+    uint32_t global_block_idx;
+    uint8_t hash_selector;
+  };
+  std::array<PreparedKey, MultiGetContext::MAX_BATCH_SIZE> prepared;
+  assert(num_keys <= static_cast<int>(MultiGetContext::MAX_BATCH_SIZE));
+
+  auto const hash_set_size = num_probes_ / 2;
+
+  for (auto i = 0; i < num_keys; ++i) {
+    uint64_t hash = GetSliceHash64(*keys[i]);
+    prepared[i].upper_32_bits_of_hash = Upper32of64(hash);
+    prepared[i].global_block_idx =
+        HashToGlobalBlockIdx(Lower32of64(hash), data_len_bytes_);
+    PrefetchBlock(GetBlockAddress(data_, prepared[i].global_block_idx));
+  }
+
   for (auto i = 0; i < num_keys; ++i) {
-    may_match[i] = MayMatch(*keys[i]);
+    uint32_t primary_global_block_idx = prepared[i].global_block_idx;
+    ReadBlock primary_block(data_, primary_global_block_idx,
+                            false /* prefetch */);
+
+    uint8_t secondary_in_batch_block_idx =
+        primary_block.GetInBatchBlockIdxOfPair();
+    auto primary_block_hash_selector =
+        GetHashSetSelector(GetInBatchBlockIdx(primary_global_block_idx),
+                           secondary_in_batch_block_idx);
+
+    may_match[i] = primary_block.AreAllBlockBloomBitsSet(
+        prepared[i].upper_32_bits_of_hash, primary_block_hash_selector,
+        hash_set_size);
+    if (may_match[i]) {
+      uint32_t batch_idx = GetContainingBatchIdx(primary_global_block_idx);
+      prepared[i].global_block_idx =
+          GetFirstGlobalBlockIdxOfBatch(batch_idx) +
+          secondary_in_batch_block_idx;
+      prepared[i].hash_selector = 1 - primary_block_hash_selector;
+      PrefetchBlock(GetBlockAddress(data_, prepared[i].global_block_idx));
+    }
+  }
+
+  for (auto i = 0; i < num_keys; ++i) {
+    if (may_match[i]) {
+      ReadBlock secondary_block(data_, prepared[i].global_block_idx,
+                                false /* prefetch */);
+      may_match[i] = secondary_block.AreAllBlockBloomBitsSet(
+          prepared[i].upper_32_bits_of_hash, prepared[i].hash_selector,
+          hash_set_size);
+    }
   }
 }
 
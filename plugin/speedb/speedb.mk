@@ -15,6 +15,7 @@
 speedb_SOURCES = 																			\
 		   speedb_registry.cc															\
 		   memtable/hash_spd_rep.cc	        							\
+		   memtable/sharded_skiplist_rep.cc								\
  			 paired_filter/speedb_paired_bloom.cc						\
  			 paired_filter/speedb_paired_bloom_internal.cc	\
 
@@ -16,6 +16,7 @@
 
 #include "paired_filter/speedb_paired_bloom.h"
 #include "plugin/speedb/memtable/hash_spd_rep.h"
+#include "plugin/speedb/memtable/sharded_skiplist_rep.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "util/string_util.h"
 
@@ -45,6 +46,22 @@ int register_SpeedbPlugins(ObjectLibrary& library, const std::string&) {
         return guard->get();
       });
 
+  library.AddFactory<MemTableRepFactory>(
+      ObjectLibrary::PatternEntry(ShardedSkipListRepFactory::kClassName(),
+                                  true)
+          .AddNumber(":"),
+      [](const std::string& uri, std::unique_ptr<MemTableRepFactory>* guard,
+         std::string* /*errmsg*/) {
+        auto colon = uri.find(":");
+        if (colon != std::string::npos) {
+          size_t num_shards = ParseSizeT(uri.substr(colon + 1));
+          guard->reset(new ShardedSkipListRepFactory(num_shards));
+        } else {
+          guard->reset(new ShardedSkipListRepFactory());
+        }
+        return guard->get();
+      });
+
   library.AddFactory<const FilterPolicy>(
       ObjectLibrary::PatternEntry(SpdbPairedBloomFilterPolicy::kClassName(),
                                   false)
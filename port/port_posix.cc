@@ -23,10 +23,15 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <unistd.h>
+#ifdef NUMA
+#include <numa.h>
+#endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "util/string_util.h"
 
@@ -268,6 +273,76 @@ void* cacheline_aligned_alloc(size_t size) {
 
 void cacheline_aligned_free(void* memblock) { free(memblock); }
 
+#ifdef NUMA
+// The ids of the NUMA nodes memory can be allocated on, in increasing order.
+// Node ids need not be contiguous, so the functions below number the nodes
+// by their index in this list.
+static const std::vector<int>& NumaNodeIds() {
+  static const std::vector<int> node_ids = []() {
+    std::vector<int> ids;
+    if (numa_available() >= 0) {
+      for (int node = 0; node <= numa_max_node(); node++) {
+        if (numa_bitmask_isbitset(numa_all_nodes_ptr, node)) {
+          ids.push_back(node);
+        }
+      }
+    }
+    return ids;
+  }();
+  return node_ids;
+}
+#endif
+
+int NumNumaNodes() {
+#ifdef NUMA
+  return std::max(static_cast<int>(NumaNodeIds().size()), 1);
+#else
+  return 1;
+#endif
+}
+
+int CurrentNumaNode() {
+#if defined(NUMA) && defined(ROCKSDB_SCHED_GETCPU_PRESENT)
+  const std::vector<int>& node_ids = NumaNodeIds();
+  int cpuno = sched_getcpu();
+  if (cpuno >= 0) {
+    int node_id = numa_node_of_cpu(cpuno);
+    auto it = std::lower_bound(node_ids.begin(), node_ids.end(), node_id);
+    // The CPUs of a node without memory count as node 0
+    if (it != node_ids.end() && *it == node_id) {
+      return static_cast<int>(it - node_ids.begin());
+    }
+  }
+#endif
+  return 0;
+}
+
+void* AllocateOnNumaNode(size_t size, int node) {
+#ifdef NUMA
+  const std::vector<int>& node_ids = NumaNodeIds();
+  if (node >= 0 && static_cast<size_t>(node) < node_ids.size()) {
+    // Page aligned, hence also cache line aligned. nullptr if the node is
+    // out of memory.
+    return numa_alloc_onnode(size, node_ids[node]);
+  }
+#else
+  (void)size;
+  (void)node;
+#endif
+  return nullptr;
+}
+
+void FreeOnNumaNode(void* memblock, size_t size) {
+#ifdef NUMA
+  numa_free(memblock, size);
+#else
+  // Never allocated
+  (void)memblock;
+  (void)size;
+  assert(false);
+#endif
+}
+
 static size_t GetPageSize() {
 #if defined(OS_LINUX) || defined(_SC_PAGESIZE)
   long v = sysconf(_SC_PAGESIZE);
@@ -194,6 +194,22 @@ static inline void AsmVolatilePause() {
 // Returns -1 if not available on this platform
 extern int PhysicalCoreID();
 
+// Number of NUMA nodes memory can be allocated on; 1 unless built with NUMA
+// support (-DNUMA) on a NUMA system. The functions below number these nodes
+// from 0 to NumNumaNodes() - 1, whatever the system's node ids are.
+extern int NumNumaNodes();
+
+// The NUMA node of the CPU the calling thread runs on, 0 if unknown
+extern int CurrentNumaNode();
+
+// Allocates cache line aligned memory on NUMA node `node`. Returns nullptr
+// if not built with NUMA support or if the node has no memory left; the
+// caller then allocates the memory elsewhere. Must be freed with
+// FreeOnNumaNode.
+extern void* AllocateOnNumaNode(size_t size, int node);
+
+extern void FreeOnNumaNode(void* memblock, size_t size);
+
 using OnceType = pthread_once_t;
 #define LEVELDB_ONCE_INIT PTHREAD_ONCE_INIT
 extern void InitOnce(OnceType* once, void (*initializer)());
@@ -256,6 +256,19 @@ static inline void AsmVolatilePause() {
 
 extern int PhysicalCoreID();
 
+// NUMA placement is not supported on Windows
+inline int NumNumaNodes() { return 1; }
+
+inline int CurrentNumaNode() { return 0; }
+
+inline void* AllocateOnNumaNode(size_t /*size*/, int /*node*/) {
+  return nullptr;
+}
+
+inline void FreeOnNumaNode(void* /*memblock*/, size_t /*size*/) {
+  assert(false);
+}
+
 // For Thread Local Storage abstraction
 using pthread_key_t = DWORD;
 
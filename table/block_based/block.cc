@@ -774,6 +774,19 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
     uint32_t region_offset = GetRestartPoint(static_cast<uint32_t>(mid));
+    // Each step depends on the comparison of the previous one, so the keys
+    // visited by a seek are a chain of dependent cache misses. Prefetch the
+    // keys of both possible next steps while this one is being compared.
+    if (mid != right) {
+      PREFETCH(data_ + GetRestartPoint(static_cast<uint32_t>(
+                           mid + (right - mid + 1) / 2)),
+               0 /* rw */, 1 /* locality */);
+    }
+    if (mid - 1 != left) {
+      PREFETCH(data_ + GetRestartPoint(
+                           static_cast<uint32_t>(left + (mid - left) / 2)),
+               0 /* rw */, 1 /* locality */);
+    }
     uint32_t shared, non_shared;
     const char* key_ptr = DecodeKeyFunc()(
         data_ + region_offset, data_ + restarts_, &shared, &non_shared);
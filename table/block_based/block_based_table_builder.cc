@@ -18,6 +18,7 @@
 #include <memory>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 
@@ -53,6 +54,7 @@
 #include "util/compression.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
+#include "util/threadpool_imp.h"
 #include "util/work_queue.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -651,12 +653,18 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     WorkQueue<BlockRep*> slot_;
   };
 
-  // Compression queue will pass references to BlockRep in block_rep_buf,
-  // and those references are always valid before the destruction of
-  // block_rep_buf.
-  using CompressQueue = WorkQueue<BlockRep*>;
-  CompressQueue compress_queue;
-  std::vector<port::Thread> compress_thread_pool;
+  // Hands the block_rep_buf entry of the given index to a compression
+  // worker. The blocks in flight are bounded by the size of block_rep_buf.
+  std::function<void(size_t)> schedule_compression;
+
+  // The compression jobs of this builder that were scheduled and did not
+  // return yet. The write thread may stop taking blocks before they are
+  // compressed (on a write error), and a job still touches the block's slot
+  // after the write thread got the block, so the builder must wait for them
+  // before it is destroyed.
+  size_t compression_jobs_in_flight = 0;
+  std::mutex compression_jobs_mutex;
+  std::condition_variable compression_jobs_cond;
 
   // Write queue will pass references to BlockRep::slot in block_rep_buf,
   // and those references are always valid before the corresponding
@@ -780,7 +788,6 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
       : curr_block_keys(new Keys()),
         block_rep_buf(parallel_threads),
         block_rep_pool(parallel_threads),
-        compress_queue(parallel_threads),
         write_queue(parallel_threads),
         first_block_processed(false) {
     for (uint32_t i = 0; i < parallel_threads; i++) {
@@ -835,9 +842,11 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     if (!write_queue.push(block_rep->slot.get())) {
       return;
     }
-    if (!compress_queue.push(block_rep)) {
-      return;
+    {
+      std::lock_guard<std::mutex> lock(compression_jobs_mutex);
+      compression_jobs_in_flight++;
     }
+    schedule_compression(static_cast<size_t>(block_rep - block_rep_buf.data()));
 
     if (!first_block_processed.load(std::memory_order_relaxed)) {
       std::unique_lock<std::mutex> lock(first_block_mutex);
@@ -1088,18 +1097,26 @@ void BlockBasedTableBuilder::WriteBlock(const Slice& uncompressed_block_data,
   }
 }
 
-void BlockBasedTableBuilder::BGWorkCompression(
-    const CompressionContext& compression_ctx,
-    UncompressionContext* verify_ctx) {
-  ParallelCompressionRep::BlockRep* block_rep = nullptr;
-  while (rep_->pc_rep->compress_queue.pop(block_rep)) {
-    assert(block_rep != nullptr);
-    CompressAndVerifyBlock(block_rep->contents, true, /* is_data_block*/
-                           compression_ctx, verify_ctx,
-                           block_rep->compressed_data.get(),
-                           &block_rep->compressed_contents,
-                           &(block_rep->compression_type), &block_rep->status);
-    block_rep->slot->Fill(block_rep);
+void BlockBasedTableBuilder::BGWorkCompression(size_t block_rep_idx) {
+  // A block_rep_buf entry is in flight at most once, so its compression
+  // contexts are not shared with other workers
+  ParallelCompressionRep::BlockRep* block_rep =
+      &rep_->pc_rep->block_rep_buf[block_rep_idx];
+  TEST_SYNC_POINT("BlockBasedTableBuilder::BGWorkCompression");
+  CompressAndVerifyBlock(block_rep->contents, true, /* is_data_block*/
+                         *(rep_->compression_ctxs[block_rep_idx]),
+                         rep_->verify_ctxs[block_rep_idx].get(),
+                         block_rep->compressed_data.get(),
+                         &block_rep->compressed_contents,
+                         &(block_rep->compression_type), &block_rep->status);
+  block_rep->slot->Fill(block_rep);
+
+  // Must be the last access to the builder, which may be destroyed as soon
+  // as the lock is released
+  ParallelCompressionRep* pc_rep = rep_->pc_rep.get();
+  std::lock_guard<std::mutex> lock(pc_rep->compression_jobs_mutex);
+  if (--pc_rep->compression_jobs_in_flight == 0) {
+    pc_rep->compression_jobs_cond.notify_all();
   }
 }
 
@@ -1348,6 +1365,12 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
       r->pc_rep->ReapBlock(block_rep);
       continue;
     }
+    if (!ok()) {
+      // Don't write the blocks that follow a failed write, but keep reaping
+      // them so that a Flush() blocked waiting for a free block can finish
+      r->pc_rep->ReapBlock(block_rep);
+      continue;
+    }
 
     for (size_t i = 0; i < block_rep->keys->Size(); i++) {
       auto& key = (*block_rep->keys)[i];
@@ -1365,7 +1388,8 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
                               block_rep->compression_type, &r->pending_handle,
                               BlockType::kData, &block_rep->contents);
     if (!ok()) {
-      break;
+      r->pc_rep->ReapBlock(block_rep);
+      continue;
     }
 
     r->props.data_size = r->get_offset();
@@ -1386,28 +1410,50 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
   }
 }
 
+namespace {
+// Compression workers shared by the table builders of all the flushes and
+// compactions of the process, so that concurrent parallel compressions use
+// the idle cores without starting parallel_threads threads each. The pool
+// grows to the largest parallel_threads of the builders that used it, up to
+// the number of hardware threads, and its threads are joined on exit like
+// those of the default Env.
+class SharedCompressionPool {
+ public:
+  static ThreadPoolImpl* Get(uint32_t parallel_threads) {
+    static SharedCompressionPool instance;
+    int max_threads =
+        std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    instance.pool_.IncBackgroundThreadsIfNeeded(
+        std::min(static_cast<int>(parallel_threads), max_threads));
+    return &instance.pool_;
+  }
+
+  ~SharedCompressionPool() { pool_.JoinAllThreads(); }
+
+ private:
+  ThreadPoolImpl pool_;
+};
+}  // namespace
+
 void BlockBasedTableBuilder::StartParallelCompression() {
   rep_->pc_rep.reset(
       new ParallelCompressionRep(rep_->compression_opts.parallel_threads));
-  rep_->pc_rep->compress_thread_pool.reserve(
-      rep_->compression_opts.parallel_threads);
-  for (uint32_t i = 0; i < rep_->compression_opts.parallel_threads; i++) {
-    rep_->pc_rep->compress_thread_pool.emplace_back([this, i] {
-      BGWorkCompression(*(rep_->compression_ctxs[i]),
-                        rep_->verify_ctxs[i].get());
-    });
-  }
+  ThreadPoolImpl* compression_pool =
+      SharedCompressionPool::Get(rep_->compression_opts.parallel_threads);
+  rep_->pc_rep->schedule_compression = [this, compression_pool](size_t idx) {
+    compression_pool->SubmitJob([this, idx] { BGWorkCompression(idx); });
+  };
   rep_->pc_rep->write_thread.reset(
       new port::Thread([this] { BGWorkWriteMaybeCompressedBlock(); }));
 }
 
 void BlockBasedTableBuilder::StopParallelCompression() {
-  rep_->pc_rep->compress_queue.finish();
-  for (auto& thread : rep_->pc_rep->compress_thread_pool) {
-    thread.join();
-  }
-  rep_->pc_rep->write_queue.finish();
-  rep_->pc_rep->write_thread->join();
+  ParallelCompressionRep* pc_rep = rep_->pc_rep.get();
+  pc_rep->write_queue.finish();
+  pc_rep->write_thread->join();
+  std::unique_lock<std::mutex> lock(pc_rep->compression_jobs_mutex);
+  pc_rep->compression_jobs_cond.wait(
+      lock, [pc_rep] { return pc_rep->compression_jobs_in_flight == 0; });
 }
 
 Status BlockBasedTableBuilder::status() const { return rep_->GetStatus(); }
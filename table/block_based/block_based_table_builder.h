@@ -167,10 +167,10 @@ class BlockBasedTableBuilder : public TableBuilder {
   // compress it
   const uint64_t kCompressionSizeLimit = std::numeric_limits<int>::max();
 
-  // Get blocks from mem-table walking thread, compress them and
-  // pass them to the write thread. Used in parallel compression mode only
-  void BGWorkCompression(const CompressionContext& compression_ctx,
-                         UncompressionContext* verify_ctx);
+  // Compress a block emitted by the mem-table walking thread and pass it to
+  // the write thread. Runs on the shared compression pool, used in parallel
+  // compression mode only
+  void BGWorkCompression(size_t block_rep_idx);
 
   // Given uncompressed block content, try to compress it and return result and
   // compression type
@@ -187,10 +187,11 @@ class BlockBasedTableBuilder : public TableBuilder {
   void BGWorkWriteMaybeCompressedBlock();
 
   // Initialize parallel compression context and
-  // start BGWorkCompression and BGWorkWriteMaybeCompressedBlock threads
+  // start the BGWorkWriteMaybeCompressedBlock thread
   void StartParallelCompression();
 
-  // Stop BGWorkCompression and BGWorkWriteMaybeCompressedBlock threads
+  // Wait for the pending blocks and stop the BGWorkWriteMaybeCompressedBlock
+  // thread
   void StopParallelCompression();
 };
 
@@ -409,6 +409,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    num_file_reads_for_auto_readahead),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"max_auto_readahead_gap_size",
+         {offsetof(struct BlockBasedTableOptions, max_auto_readahead_gap_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
 
 };
 
@@ -853,6 +857,10 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
            "  num_file_reads_for_auto_readahead: %" PRIu64 "\n",
            table_options_.num_file_reads_for_auto_readahead);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "  max_auto_readahead_gap_size: %" ROCKSDB_PRIszt "\n",
+           table_options_.max_auto_readahead_gap_size);
+  ret.append(buffer);
   return ret;
 }
 
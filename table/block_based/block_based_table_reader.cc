@@ -2187,6 +2187,76 @@ Status BlockBasedTable::MultiGetFilter(const ReadOptions& read_options,
   return Status::OK();
 }
 
+void BlockBasedTable::PrefetchMultiGetDataBlocks(
+    const ReadOptions& read_options, const MultiGetRange* mget_range,
+    const SliceTransform* prefix_extractor) {
+  if (mget_range->empty() || read_options.read_tier == kBlockCacheTier ||
+      rep_->file->use_direct_io()) {
+    // The file system only reads ahead into the OS page cache
+    return;
+  }
+
+  GetContext* get_context = mget_range->begin()->get_context;
+  BlockCacheLookupContext lookup_context{TableReaderCaller::kUserMultiGet};
+  IndexBlockIter iiter_on_stack;
+  bool need_upper_bound_check = false;
+  if (rep_->index_type == BlockBasedTableOptions::kHashSearch) {
+    need_upper_bound_check = PrefixExtractorChanged(prefix_extractor);
+  }
+  auto iiter = NewIndexIterator(read_options, need_upper_bound_check,
+                                &iiter_on_stack, get_context, &lookup_context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  uint64_t prefetch_offset = 0;
+  size_t prefetch_len = 0;
+  auto prefetch = [&]() {
+    if (prefetch_len > 0) {
+      // Best effort, the blocks are read again by MultiGet() anyway
+      rep_->file
+          ->Prefetch(prefetch_offset, prefetch_len,
+                     read_options.rate_limiter_priority)
+          .PermitUncheckedError();
+    }
+  };
+
+  uint64_t prev_offset = std::numeric_limits<uint64_t>::max();
+  for (auto miter = mget_range->begin(); miter != mget_range->end(); ++miter) {
+    iiter->Seek(miter->ikey);
+    if (!iiter->Valid()) {
+      continue;
+    }
+    const BlockHandle& handle = iiter->value().handle;
+    if (handle.offset() == prev_offset) {
+      continue;
+    }
+    prev_offset = handle.offset();
+    if (block_cache != nullptr) {
+      CacheKey key = GetCacheKey(rep_->base_cache_key, handle);
+      Cache::Handle* cache_handle =
+          block_cache->BasicLookup(key.AsSlice(), /*stats=*/nullptr);
+      if (cache_handle != nullptr) {
+        block_cache->Release(cache_handle);
+        continue;
+      }
+    }
+    const size_t block_len = BlockSizeWithTrailer(handle);
+    if (prefetch_len > 0 &&
+        prefetch_offset + prefetch_len == handle.offset()) {
+      // Adjacent blocks are read ahead together
+      prefetch_len += block_len;
+    } else {
+      prefetch();
+      prefetch_offset = handle.offset();
+      prefetch_len = block_len;
+    }
+  }
+  prefetch();
+}
+
 Status BlockBasedTable::Prefetch(const Slice* const begin,
                                  const Slice* const end) {
   auto& comparator = rep_->internal_comparator;
@@ -144,6 +144,10 @@ class BlockBasedTable : public TableReader {
                         const SliceTransform* prefix_extractor,
                         MultiGetRange* mget_range) override;
 
+  void PrefetchMultiGetDataBlocks(
+      const ReadOptions& read_options, const MultiGetRange* mget_range,
+      const SliceTransform* prefix_extractor) override;
+
   DECLARE_SYNC_AND_ASYNC_OVERRIDE(void, MultiGet,
                                   const ReadOptions& readOptions,
                                   const MultiGetContext::Range* mget_range,
@@ -643,7 +647,8 @@ struct BlockBasedTable::Rep {
         !ioptions.allow_mmap_reads /* enable */, false /* track_min_offset */,
         implicit_auto_readahead, num_file_reads,
         num_file_reads_for_auto_readahead, ioptions.fs.get(), ioptions.clock,
-        ioptions.stats));
+        ioptions.stats, FilePrefetchBufferUsage::kUnknown,
+        table_options.max_auto_readahead_gap_size));
   }
 
   void CreateFilePrefetchBufferIfNotExists(
@@ -70,7 +70,8 @@ void BlockPrefetcher::PrefetchIfNeeded(
     return;
   }
 
-  if (!IsBlockSequential(offset)) {
+  if (!IsBlockSequential(offset,
+                         rep->table_options.max_auto_readahead_gap_size)) {
     UpdateReadPattern(offset, len);
     ResetValues(rep->table_options.initial_auto_readahead_size);
     return;
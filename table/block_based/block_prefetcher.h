@@ -30,8 +30,11 @@ class BlockPrefetcher {
     prev_len_ = len;
   }
 
-  bool IsBlockSequential(const uint64_t& offset) {
-    return (prev_len_ == 0 || (prev_offset_ + prev_len_ == offset));
+  // A read that starts at most max_gap bytes after the end of the previous
+  // read is sequential too
+  bool IsBlockSequential(const uint64_t& offset, size_t max_gap = 0) {
+    return (prev_len_ == 0 || (offset >= prev_offset_ + prev_len_ &&
+                               offset - (prev_offset_ + prev_len_) <= max_gap));
   }
 
   void ResetValues(size_t initial_auto_readahead_size) {
@@ -26,6 +26,16 @@ Status Iterator::GetProperty(std::string prop_name, std::string* prop) {
   return Status::InvalidArgument("Unidentified property.");
 }
 
+void Iterator::SeekMany(const std::vector<Slice>& targets,
+                        const std::function<bool(size_t)>& callback) {
+  for (size_t i = 0; i < targets.size(); ++i) {
+    Seek(targets[i]);
+    if (!callback(i)) {
+      break;
+    }
+  }
+}
+
 namespace {
 class EmptyIterator : public Iterator {
  public:
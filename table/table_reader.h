@@ -138,6 +138,15 @@ class TableReader {
     return Status::NotSupported();
   }
 
+  // Hints the file system to start reading the data blocks that may hold the
+  // keys of mget_range, so that the reads of several files that are looked up
+  // one after the other overlap. Doesn't wait for the reads and doesn't
+  // consult the filters (see MultiGetFilter()).
+  virtual void PrefetchMultiGetDataBlocks(
+      const ReadOptions& /*readOptions*/,
+      const MultiGetContext::Range* /*mget_range*/,
+      const SliceTransform* /*prefix_extractor*/) {}
+
   virtual void MultiGet(const ReadOptions& readOptions,
                         const MultiGetContext::Range* mget_range,
                         const SliceTransform* prefix_extractor,
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Speedb Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A count-min sketch of 4-bit counters, estimating how many times each key
+// was recorded recently (as in TinyLFU). Once 10 records per counter were
+// made, all the counters are halved, so the estimates follow the recent
+// frequencies. Thread-safe: concurrent records may only be slightly lost
+// while the counters are halved.
+//
+// Keys are given by a 64-bit hash.
+class FrequencySketch {
+ public:
+  static constexpr uint32_t kMaxFrequency = 15;
+
+  // num_counters is rounded up to a power of 2, and at least 16
+  explicit FrequencySketch(size_t num_counters) {
+    size_t num_words = 1;
+    while (num_words * kCountersPerWord < num_counters) {
+      num_words <<= 1;
+    }
+    num_words_ = num_words;
+    words_.reset(new std::atomic<uint64_t>[num_words_]);
+    for (size_t i = 0; i < num_words_; ++i) {
+      words_[i].store(0, std::memory_order_relaxed);
+    }
+    sample_size_ = 10 * num_words_ * kCountersPerWord;
+  }
+
+  // Records an occurrence of the key and returns its estimated number of
+  // recent occurrences, including this one (at most kMaxFrequency)
+  uint32_t Record(uint64_t hash) {
+    uint32_t frequency = kMaxFrequency;
+    for (int i = 0; i < kNumHashes; ++i) {
+      size_t counter = CounterIndex(hash, i);
+      std::atomic<uint64_t>& word = words_[counter / kCountersPerWord];
+      int shift = static_cast<int>(counter % kCountersPerWord) * 4;
+      uint64_t old_word = word.load(std::memory_order_relaxed);
+      uint32_t count;
+      do {
+        count = static_cast<uint32_t>((old_word >> shift) & 0xF);
+        if (count == kMaxFrequency) {
+          break;
+        }
+      } while (!word.compare_exchange_weak(old_word,
+                                           old_word + (uint64_t{1} << shift),
+                                           std::memory_order_relaxed));
+      frequency = std::min(frequency, std::min(count + 1, kMaxFrequency));
+    }
+    if (num_records_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+        sample_size_) {
+      // Only one thread reaches the sample size
+      Age();
+      num_records_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+    }
+    return frequency;
+  }
+
+  // Returns the estimated number of recent occurrences of the key
+  uint32_t Estimate(uint64_t hash) const {
+    uint32_t frequency = kMaxFrequency;
+    for (int i = 0; i < kNumHashes; ++i) {
+      size_t counter = CounterIndex(hash, i);
+      uint64_t word =
+          words_[counter / kCountersPerWord].load(std::memory_order_relaxed);
+      int shift = static_cast<int>(counter % kCountersPerWord) * 4;
+      frequency =
+          std::min(frequency, static_cast<uint32_t>((word >> shift) & 0xF));
+    }
+    return frequency;
+  }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(*this) + num_words_ * sizeof(uint64_t);
+  }
+
+ private:
+  static constexpr size_t kCountersPerWord = 16;
+  static constexpr int kNumHashes = 4;
+
+  // Double hashing over the two halves of the hash
+  size_t CounterIndex(uint64_t hash, int i) const {
+    uint32_t h1 = static_cast<uint32_t>(hash);
+    uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+    return static_cast<size_t>(h1 + static_cast<uint32_t>(i) * h2) &
+           (num_words_ * kCountersPerWord - 1);
+  }
+
+  void Age() {
+    for (size_t i = 0; i < num_words_; ++i) {
+      uint64_t word = words_[i].load(std::memory_order_relaxed);
+      words_[i].store((word >> 1) & 0x7777777777777777ULL,
+                      std::memory_order_relaxed);
+    }
+  }
+
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  size_t num_words_;
+  size_t sample_size_;
+  std::atomic<size_t> num_records_{0};
+};
+
+}  // namespace ROCKSDB_NAMESPACE
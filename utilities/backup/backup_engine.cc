@@ -48,6 +48,7 @@
 #include "util/channel.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/defer.h"
 #include "util/math.h"
 #include "util/rate_limiter.h"
 #include "util/string_util.h"
@@ -124,6 +125,8 @@ void BackupEngineOptions::Dump(Logger* logger) const {
                  restore_rate_limit);
   ROCKS_LOG_INFO(logger, "Options.max_background_operations: %d",
                  max_background_operations);
+  ROCKS_LOG_INFO(logger, "    Options.pipelined_file_copy: %d",
+                 static_cast<int>(pipelined_file_copy));
 }
 
 namespace {
@@ -2205,19 +2208,83 @@ IOStatus BackupEngineImpl::CopyOrCreateFile(
 
     src_reader.reset(new SequentialFileReader(
         std::move(src_file), src, nullptr /* io_tracer */, {}, rate_limiter));
-    buf.reset(new char[buf_size]);
+    if (!options_.pipelined_file_copy) {
+      buf.reset(new char[buf_size]);
+    }
+  }
+
+  // Bytes of the source file left to read, not counting the pending read
+  uint64_t read_limit = size_limit;
+  auto read_chunk = [&](char* scratch, Slice* result) {
+    size_t buffer_to_read =
+        (buf_size < read_limit) ? buf_size : static_cast<size_t>(read_limit);
+    IOStatus s = src_reader->Read(buffer_to_read, result, scratch,
+                                  Env::IO_LOW /* rate_limiter_priority */);
+    read_limit -= result->size();
+    return s;
+  };
+
+  // With pipelined_file_copy, read_thread reads the chunks of the file into
+  // the buffers it gets from free_chunks and hands them over through
+  // read_chunks, so the next chunk is read while the current one is
+  // checksummed and written. Each buffer goes back to free_chunks once its
+  // chunk is written.
+  struct Chunk {
+    std::unique_ptr<char[]> buf;
+    Slice data;
+    IOStatus io_s;
+  };
+  const bool pipelined = options_.pipelined_file_copy && !src.empty();
+  channel<Chunk> free_chunks;
+  channel<Chunk> read_chunks;
+  port::Thread read_thread;
+  Defer join_read_thread([&]() {
+    if (read_thread.joinable()) {
+      free_chunks.sendEof();
+      read_thread.join();
+    }
+  });
+  if (pipelined) {
+    for (int i = 0; i < 2; i++) {
+      free_chunks.write(Chunk{std::unique_ptr<char[]>(new char[buf_size]),
+                              Slice(), IOStatus::OK()});
+    }
+    read_thread = port::Thread([&]() {
+      Chunk chunk;
+      while (free_chunks.read(chunk)) {
+        chunk.io_s = read_chunk(chunk.buf.get(), &chunk.data);
+        bool last =
+            !chunk.io_s.ok() || chunk.data.size() == 0 || read_limit == 0;
+        read_chunks.write(std::move(chunk));
+        if (last) {
+          break;
+        }
+      }
+      read_chunks.sendEof();
+    });
   }
 
   Slice data;
+  Chunk chunk;
   do {
     if (stop_backup_.load(std::memory_order_acquire)) {
       return status_to_io_status(Status::Incomplete("Backup stopped"));
     }
-    if (!src.empty()) {
-      size_t buffer_to_read =
-          (buf_size < size_limit) ? buf_size : static_cast<size_t>(size_limit);
-      io_s = src_reader->Read(buffer_to_read, &data, buf.get(),
-                              Env::IO_LOW /* rate_limiter_priority */);
+    if (pipelined) {
+      if (chunk.buf) {
+        free_chunks.write(std::move(chunk));
+      }
+      if (read_chunks.read(chunk)) {
+        io_s = chunk.io_s;
+        data = chunk.data;
+      } else {
+        data = Slice();
+      }
+      // The I/O stats of the read went to read_thread, account them here
+      IOSTATS_ADD(bytes_read, data.size());
+      *bytes_toward_next_callback += data.size();
+    } else if (!src.empty()) {
+      io_s = read_chunk(buf.get(), &data);
       *bytes_toward_next_callback += data.size();
     } else {
       data = contents;
@@ -4067,6 +4067,36 @@ TEST_F(BackupEngineTest, IOStats) {
             2 * options_.statistics->getTickerCount(BACKUP_READ_BYTES));
 }
 
+TEST_F(BackupEngineTest, PipelinedFileCopy) {
+  engine_options_->pipelined_file_copy = true;
+  // The copy buffer is as large as the rate limiter burst; keep it small so
+  // that files are copied in several chunks
+  std::shared_ptr<RateLimiter> rate_limiter(NewGenericRateLimiter(
+      64 << 20 /* rate_bytes_per_sec */, 1000 /* refill_period_us */));
+  engine_options_->backup_rate_limiter = rate_limiter;
+  engine_options_->restore_rate_limiter = rate_limiter;
+
+  options_.statistics = CreateDBStatistics();
+  OpenDBAndBackupEngine(true /* destroy_old_data */, false /* dummy */,
+                        kShareWithChecksum);
+
+  FillDB(db_.get(), 0 /* from */, 10000 /* to */, kFlushMost);
+  ASSERT_OK(backup_engine_->CreateNewBackup(db_.get(),
+                                            false /* flush_before_backup */));
+
+  size_t backup_files_size;
+  ASSERT_OK(GetSizeOfBackupFiles(test_backup_env_->GetFileSystem().get(),
+                                 backupdir_, &backup_files_size));
+  ASSERT_EQ(backup_files_size,
+            options_.statistics->getTickerCount(BACKUP_WRITE_BYTES));
+  ASSERT_GE(options_.statistics->getTickerCount(BACKUP_READ_BYTES),
+            backup_files_size);
+  ASSERT_OK(backup_engine_->VerifyBackup(1, true /* verify_with_checksum */));
+  CloseDBAndBackupEngine();
+
+  AssertBackupConsistency(0, 0, 10000, 10100);
+}
+
 TEST_F(BackupEngineTest, FileTemperatures) {
   CloseDBAndBackupEngine();
 
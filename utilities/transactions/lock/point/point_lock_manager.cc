@@ -11,6 +11,7 @@
 #include <mutex>
 
 #include "monitoring/perf_context_imp.h"
+#include "port/port.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/utilities/transaction_db_mutex.h"
 #include "test_util/sync_point.h"
@@ -45,7 +46,9 @@ struct LockInfo {
   DECLARE_DEFAULT_MOVES(LockInfo);
 };
 
-struct LockMapStripe {
+// Aligned so that the stripes, which are allocated one after the other, don't
+// false share.
+struct ALIGN_AS(CACHE_LINE_SIZE) LockMapStripe {
   explicit LockMapStripe(std::shared_ptr<TransactionDBMutexFactory> factory) {
     stripe_mutex = factory->AllocateMutex();
     stripe_cv = factory->AllocateCondVar();
@@ -59,6 +62,10 @@ struct LockMapStripe {
   // Condition Variable per stripe for waiting on a lock
   std::shared_ptr<TransactionDBCondVar> stripe_cv;
 
+  // Number of threads waiting on stripe_cv. Only modified with stripe_mutex
+  // held, so that unlocking without a conflict doesn't notify stripe_cv.
+  std::atomic<int> num_waiters{0};
+
   // Locked keys mapped to the info about the transactions that locked them.
   // TODO(agiardullo): Explore performance of other data structures.
   UnorderedMap<std::string, LockInfo> keys;
@@ -314,6 +321,7 @@ Status PointLockManager::AcquireWithTimeout(
       }
 
       TEST_SYNC_POINT("PointLockManager::AcquireWithTimeout:WaitingTxn");
+      stripe->num_waiters.fetch_add(1, std::memory_order_relaxed);
       if (cv_end_time < 0) {
         // Wait indefinitely
         result = stripe->stripe_cv->Wait(stripe->stripe_mutex);
@@ -324,6 +332,7 @@ Status PointLockManager::AcquireWithTimeout(
                                               cv_end_time - now);
         }
       }
+      stripe->num_waiters.fetch_sub(1, std::memory_order_relaxed);
 
       if (wait_ids.size() != 0) {
         txn->ClearWaitingTxn();
@@ -593,10 +602,15 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
 
   stripe->stripe_mutex->Lock().PermitUncheckedError();
   UnLockKey(txn, key, stripe, lock_map, env);
+  // A waiter registers itself before releasing the stripe mutex in Wait(), so
+  // it is seen here if it is waiting for this key
+  bool has_waiters = stripe->num_waiters.load(std::memory_order_relaxed) > 0;
   stripe->stripe_mutex->UnLock();
 
-  // Signal waiting threads to retry locking
-  stripe->stripe_cv->NotifyAll();
+  if (has_waiters) {
+    // Signal waiting threads to retry locking
+    stripe->stripe_cv->NotifyAll();
+  }
 }
 
 void PointLockManager::UnLock(PessimisticTransaction* txn,
@@ -613,36 +627,40 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
       return;
     }
 
-    // Bucket keys by lock_map_ stripe
-    UnorderedMap<size_t, std::vector<const std::string*>> keys_by_stripe(
-        lock_map->num_stripes_);
+    // Bucket keys by lock_map_ stripe, by sorting them by stripe (a single
+    // allocation instead of a map of vectors)
+    std::vector<std::pair<size_t, const std::string*>> keys_by_stripe;
+    keys_by_stripe.reserve(tracker.GetNumPointLocks());
     std::unique_ptr<LockTracker::KeyIterator> key_it(
         tracker.GetKeyIterator(cf));
     assert(key_it != nullptr);
     while (key_it->HasNext()) {
       const std::string& key = key_it->Next();
-      size_t stripe_num = lock_map->GetStripe(key);
-      keys_by_stripe[stripe_num].push_back(&key);
+      keys_by_stripe.emplace_back(lock_map->GetStripe(key), &key);
     }
+    std::sort(keys_by_stripe.begin(), keys_by_stripe.end());
 
     // For each stripe, grab the stripe mutex and unlock all keys in this stripe
-    for (auto& stripe_iter : keys_by_stripe) {
-      size_t stripe_num = stripe_iter.first;
-      auto& stripe_keys = stripe_iter.second;
+    for (auto it = keys_by_stripe.begin(); it != keys_by_stripe.end();) {
+      size_t stripe_num = it->first;
 
       assert(lock_map->lock_map_stripes_.size() > stripe_num);
       LockMapStripe* stripe = lock_map->lock_map_stripes_.at(stripe_num);
 
       stripe->stripe_mutex->Lock().PermitUncheckedError();
 
-      for (const std::string* key : stripe_keys) {
-        UnLockKey(txn, *key, stripe, lock_map, env);
+      for (; it != keys_by_stripe.end() && it->first == stripe_num; ++it) {
+        UnLockKey(txn, *it->second, stripe, lock_map, env);
       }
 
+      bool has_waiters =
+          stripe->num_waiters.load(std::memory_order_relaxed) > 0;
       stripe->stripe_mutex->UnLock();
 
-      // Signal waiting threads to retry locking
-      stripe->stripe_cv->NotifyAll();
+      if (has_waiters) {
+        // Signal waiting threads to retry locking
+        stripe->stripe_cv->NotifyAll();
+      }
     }
   }
 }
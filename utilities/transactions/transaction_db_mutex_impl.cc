@@ -11,11 +11,15 @@
 #include <functional>
 #include <mutex>
 
+#include "port/port.h"
 #include "rocksdb/utilities/transaction_db_mutex.h"
 
 namespace ROCKSDB_NAMESPACE {
 
-class TransactionDBMutexImpl : public TransactionDBMutex {
+// The mutexes and condition variables of the lock stripes are allocated one
+// after the other, align them so that the stripes don't false share.
+class ALIGN_AS(CACHE_LINE_SIZE) TransactionDBMutexImpl
+    : public TransactionDBMutex {
  public:
   TransactionDBMutexImpl() {}
   ~TransactionDBMutexImpl() override {}
@@ -32,7 +36,8 @@ class TransactionDBMutexImpl : public TransactionDBMutex {
   std::mutex mutex_;
 };
 
-class TransactionDBCondVarImpl : public TransactionDBCondVar {
+class ALIGN_AS(CACHE_LINE_SIZE) TransactionDBCondVarImpl
+    : public TransactionDBCondVar {
  public:
   TransactionDBCondVarImpl() {}
   ~TransactionDBCondVarImpl() override {}